@@ -6,6 +6,7 @@
 #include <iostream>
 #include <utility>
 #include <cmath>
+#include <thread>
 
 // third party
 #include <SFML/Graphics.hpp>
@@ -20,14 +21,26 @@
 #include <dev/object/Visible.h>
 #include <dev/object/Hearable.h>
 #include <dev/object/Collidable.h>
+#include <dev/object/Mob.h>
 
 // lib
 #include <lib/Animation.h>
+#include <lib/AnimationManager.h>
+#include <lib/CollisionManager.h>
 #include <lib/FPSManager.h>
+#include <lib/InputManager.h>
+#include <lib/InputRecorder.h>
+#include <lib/JobManager.h>
 #include <lib/KeyManager.h>
 #include <lib/MouseManager.h>
+#include <lib/ObjectManager.h>
+#include <lib/PhysicsManager.h>
+#include <lib/ResourceManager.h>
+#include <lib/SoundManager.h>
+#include <lib/SpriteBatch.h>
 #include <lib/SpriteGenerator.h>
 #include <lib/WrapImage.h>
+#include <lib/WrapMusic.h>
 #include <lib/WrapTexture.h>
 #include <lib/WrapSoundBuffer.h>
 
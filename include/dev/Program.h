@@ -1,9 +1,51 @@
 #ifndef SFML_DEV_PROGRAM_H_
 #define SFML_DEV_PROGRAM_H_
 
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/System/Time.hpp>
+
+using u64 = unsigned long long;
+using usize = unsigned long;
+using f32 = float;
+using UpdateCallback = std::function<void(sf::Time const &)>;
+using SnapshotCallback = std::function<void(usize const &, f32 const &)>;
+using DrawCallback = std::function<void(sf::RenderTarget &, usize const &)>;
+
 class Program {
  public:
+  enum {
+    kSnapshotCount = 2,
+  };
+
   static void run();
+  static void close() noexcept;
+
+  static u64 const &getTickRate() noexcept;
+  static void setTickRate(u64 const &tick_rate);
+
+  static usize const &getMaxCatchUp() noexcept;
+  static void setMaxCatchUp(usize const &max_catch_up);
+
+  static bool const &isPipelined() noexcept;
+  static void setPipelined(bool const &is_pipelined) noexcept;
+
+  static sf::Time const &getUploadBudget() noexcept;
+  static void setUploadBudget(sf::Time const &upload_budget) noexcept;
+
+  static u64 const &getTickCount() noexcept;
+
+  // session input goes to the file when the program ends
+  static std::string const &getRecordFilename() noexcept;
+  static void setRecordFilename(std::string const &filename);
+  // runs the recorded input on its ticks, window hidden and frames
+  // unthrottled, and closes after as many ticks as the session ran
+  static std::string const &getReplayFilename() noexcept;
+  static void setReplayFilename(std::string const &filename);
 
  private:
   Program() = delete;
@@ -11,7 +53,28 @@ class Program {
   Program &operator=(Program const &rhs) = delete;
   ~Program() = delete;
 
-  static void loop();
+  static void loop(sf::RenderWindow &window,
+                   UpdateCallback const &update,
+                   SnapshotCallback const &snapshot,
+                   DrawCallback const &draw);
+  static void renderLoop(sf::RenderWindow &window, DrawCallback const &draw);
+  static void eventProcess(sf::RenderWindow &window);
+
+  static u64 tick_rate_;
+  static sf::Time tick_;
+  static usize max_catch_up_;
+  static u64 tick_count_;
+  static bool is_closing_;
+  static bool is_pipelined_;
+  static sf::Time upload_budget_;
+  static std::string record_filename_;
+  static std::string replay_filename_;
+
+  static std::mutex mutex_;
+  static std::condition_variable condition_;
+  static usize published_;
+  static bool is_drawing_[kSnapshotCount];
+  static bool is_rendering_;
 }; // Program
 
 #endif // SFML_DEV_PROGRAM_H_
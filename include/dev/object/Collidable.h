@@ -2,13 +2,26 @@
 #define SFML_DEV_OBJECT_COLLIDABLE_H_
 
 #include <dev/object/Object.h>
+#include <lib/CollisionManager.h>
+
+using usize = unsigned long;
 
 class Collidable : virtual public Object {
  public:
   explicit Collidable() = delete;
   explicit Collidable(Collidable const &rhs) = delete;
   Collidable &operator=(Collidable const &rhs) = delete;
-  ~Collidable() = delete;
+  virtual ~Collidable() noexcept;
+
+  // local to the object, transformed by it for the broad phase
+  virtual sf::FloatRect const &getHitbox() const;
+  virtual void setHitbox(sf::FloatRect const &hitbox);
+  virtual sf::FloatRect getGlobalBounds() const;
+
+  // -1 until the first updateCollider
+  virtual usize const &getColliderCode() const;
+  // once per tick after moving, registers on the first call
+  virtual void updateCollider();
 
   virtual void initialize() = 0;
   virtual void update() = 0;
@@ -17,14 +30,18 @@ class Collidable : virtual public Object {
 
  protected:
   struct Inner : virtual public Object::Inner {
+    sf::FloatRect hitbox_;
+    usize collider_code_;
 
     explicit Inner();
     explicit Inner(Inner const &rhs);
     virtual Inner &operator=(Inner const &rhs);
-  };
+    virtual ~Inner();
+  } *collidable_ownership;
+
+  explicit Collidable(Collidable::Inner *const &ownership) noexcept;
 
  private:
-  explicit Collidable(Collidable::Inner *const &ownership) = delete;
   virtual void ownershipCheck() const = 0;
 }; // Collidable
 
@@ -2,13 +2,25 @@
 #define SFML_DEV_OBJECT_HEARABLE_H_
 
 #include <dev/object/Object.h>
+#include <lib/SoundManager.h>
+
+using usize = unsigned long;
 
 class Hearable : virtual public Object {
  public:
   explicit Hearable() = delete;
   explicit Hearable(Hearable const &rhs) = delete;
   Hearable &operator=(Hearable const &rhs) = delete;
-  ~Hearable() = delete;
+  virtual ~Hearable() noexcept;
+
+  virtual f32 const &getAudibleRange() const;
+  virtual void setAudibleRange(f32 const &audible_range);
+  virtual bool isAudible() const;
+
+  // plays at getPosition(), inaudible emitters never take a voice
+  virtual usize emit(usize const &sound_code,
+                     f32 const &volume = 100.0f,
+                     f32 const &pitch = 1.0f) const;
 
   virtual void initialize() = 0;
   virtual void update() = 0;
@@ -17,14 +29,16 @@ class Hearable : virtual public Object {
 
  protected:
   struct Inner : virtual public Object::Inner {
+    f32 audible_range_;
 
     explicit Inner();
     explicit Inner(Inner const &rhs);
     virtual Inner &operator=(Inner const &rhs);
-  };
+  } *hearable_ownership;
+
+  explicit Hearable(Hearable::Inner *const &ownership) noexcept;
 
  private:
-  explicit Hearable(Hearable::Inner *const &ownership) = delete;
   virtual void ownershipCheck() const = 0;
 }; // Hearable
 
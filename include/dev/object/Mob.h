@@ -0,0 +1,35 @@
+#ifndef SFML_DEV_OBJECT_MOB_H_
+#define SFML_DEV_OBJECT_MOB_H_
+
+#include <dev/object/Collidable.h>
+#include <dev/object/Hearable.h>
+#include <dev/object/Visible.h>
+
+class Mob : public Visible, public Collidable, public Hearable {
+ public:
+  explicit Mob();
+  explicit Mob(Mob const &rhs) = delete;
+  Mob &operator=(Mob const &rhs) = delete;
+  virtual ~Mob() noexcept;
+
+  virtual void initialize();
+  // once per tick after the body moved it
+  virtual void update();
+  virtual void render();
+  virtual void release();
+
+ private:
+  struct Inner : virtual public Visible::Inner,
+                 virtual public Collidable::Inner,
+                 virtual public Hearable::Inner {
+    explicit Inner();
+    explicit Inner(Inner const &rhs);
+    virtual Inner &operator=(Inner const &rhs);
+  };
+
+  explicit Mob(Mob::Inner *const &ownership) noexcept;
+
+  virtual void ownershipCheck() const;
+}; // Mob
+
+#endif // SFML_DEV_OBJECT_MOB_H_
@@ -3,6 +3,8 @@
 
 #include <SFML/Graphics.hpp>
 
+#include <lib/ObjectManager.h>
+
 using f32 = float;
 
 class Object {
@@ -10,13 +12,14 @@ class Object {
   explicit Object() = delete;
   explicit Object(Object const &rhs) = delete;
   Object &operator=(Object const &rhs) = delete;
-  ~Object() = delete;
+  virtual ~Object() noexcept;
 
   virtual sf::Vector2f const &getPosition() const;
   virtual f32 const &getZDepth() const;
   virtual f32 const &getRotation() const;
   virtual sf::Vector2f const &getScale() const;
   virtual sf::Vector2f const &getOrigin() const;
+  virtual ObjectManager::Handle const &getHandle() const;
   virtual void setPosition(f32 x, f32 y);
   virtual void setPosition(sf::Vector2f const &position);
   virtual void setZDepth(f32 const &z_depth);
@@ -32,20 +35,20 @@ class Object {
   virtual void release() = 0;
 
  protected:
+  // the transform itself lives in ObjectManager
   struct Inner {
-    sf::Vector2f position_;
-    f32 z_depth_;
-    f32 rotation_;
-    sf::Vector2f scale_;
-    sf::Vector2f origin_;
+    ObjectManager::Handle handle_;
 
     explicit Inner();
     explicit Inner(Inner const &rhs);
     virtual Inner &operator=(Inner const &rhs);
+    virtual ~Inner();
   } *ownership;
 
+  // the most derived class makes the Inner and hands it to every base
+  explicit Object(Object::Inner *const &ownership) noexcept;
+
  private:
-  explicit Object(Object::Inner *const &ownership) = delete;
   virtual void ownershipCheck() const = 0;
 }; // Object
 
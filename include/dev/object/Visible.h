@@ -2,13 +2,26 @@
 #define SFML_DEV_OBJECT_VISIBLE_H_
 
 #include <dev/object/Object.h>
+#include <lib/SpriteBatch.h>
 
 class Visible : virtual public Object {
  public:
   explicit Visible() = delete;
   explicit Visible(Visible const &rhs) = delete;
   Visible &operator=(Visible const &rhs) = delete;
-  ~Visible() = delete;
+  virtual ~Visible() noexcept;
+
+  virtual sf::Texture const *getTexture() const;
+  virtual sf::IntRect const &getTextureRect() const;
+  virtual sf::Color const &getColor() const;
+  virtual SpriteBatch::Layer const &getLayer() const;
+  virtual void setTexture(sf::Texture const *const &texture);
+  virtual void setTextureRect(sf::IntRect const &texture_rect);
+  virtual void setColor(sf::Color const &color);
+  virtual void setLayer(SpriteBatch::Layer const &layer);
+
+  // queued under its layer, z depth orders it inside the layer
+  virtual void submit(SpriteBatch &sprite_batch) const;
 
   virtual void initialize() = 0;
   virtual void update() = 0;
@@ -17,14 +30,19 @@ class Visible : virtual public Object {
 
  protected:
   struct Inner : virtual public Object::Inner {
+    sf::Texture const *texture_;
+    sf::IntRect texture_rect_;
+    sf::Color color_;
+    SpriteBatch::Layer layer_;
 
     explicit Inner();
     explicit Inner(Inner const &rhs);
     virtual Inner &operator=(Inner const &rhs);
-  };
+  } *visible_ownership;
+
+  explicit Visible(Visible::Inner *const &ownership) noexcept;
 
  private:
-  explicit Visible(Visible::Inner *const &ownership) = delete;
   virtual void ownershipCheck() const = 0;
 }; // Visible
 
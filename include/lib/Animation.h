@@ -7,11 +7,20 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System/Time.hpp>
 
+using i32 = int;
 using usize = unsigned long;
+using f32 = float;
 using Motion = std::pair<sf::IntRect, sf::Time>;
 using Anime = std::vector<Motion>;
 using AnimeStore = std::vector<Anime>;
 
+// corners clockwise from the top left, positions around the origin and
+// texcoords in texture pixels as sfml expects them
+struct MotionQuad {
+  sf::Vector2f positions[4];
+  sf::Vector2f tex_coords[4];
+};
+
 class Animation {
  public:
   explicit Animation();
@@ -30,12 +39,33 @@ class Animation {
   virtual void setMotionCount(usize const &anime_code,
                               usize const &motion_count);
 
-  virtual AnimeStore const &getAnimes() const;
+  // built from the flat storage, prefer getMotions on hot paths
+  virtual AnimeStore getAnimes() const;
   virtual void setAnimes(AnimeStore const &animes);
 
-  virtual Anime const &getAnime(usize const &anime_code) const;
+  virtual Anime getAnime(usize const &anime_code) const;
   virtual void setAnime(usize const &anime_code, Anime const &anime);
 
+  // contiguous motions of one anime, valid until the next set
+  virtual Motion const *getMotions(usize const &anime_code) const;
+  virtual sf::Time const &getDuration(usize const &anime_code) const;
+  // zero unless every motion of the anime lasts the same
+  virtual sf::Time const &getFrameTime(usize const &anime_code) const;
+  // motion playing at elapsed from the anime start, the last one past
+  // the end, o(1) for uniform frame times and a binary search otherwise
+  virtual usize getMotionCode(usize const &anime_code,
+                              sf::Time const &elapsed) const;
+
+  // bakes every motion into a quad for a texture of that size, later sets
+  // bake their motions again with the same texture size and origin
+  virtual void bake(sf::Vector2u const &texture_size,
+                    sf::Vector2f const &origin = sf::Vector2f(0, 0));
+  virtual bool isBaked() const;
+  // parallel to getMotions, valid until the next set
+  virtual MotionQuad const *getQuads(usize const &anime_code) const;
+  virtual MotionQuad const &getQuad(usize const &anime_code,
+                                    usize const &motion_code) const;
+
   virtual Motion const &getMotion(usize const &anime_code,
                                   usize const &motion_code) const;
   virtual void setMotion(usize const &anime_code,
@@ -43,8 +73,18 @@ class Animation {
                          Motion const &motion);
 
  protected:
+  // every anime back to back in one array, anime i owns the motions in
+  // [offsets_[i], offsets_[i + 1]) and ends_ holds the running total of
+  // durations inside its anime
   struct Inner {
-    AnimeStore animes_;
+    std::vector<Motion> motions_;
+    std::vector<sf::Time> ends_;
+    std::vector<usize> offsets_;
+    std::vector<sf::Time> frame_times_;
+    std::vector<MotionQuad> quads_; // empty until baked
+    sf::Vector2u texture_size_;
+    sf::Vector2f origin_;
+    bool is_baked_;
 
     explicit Inner();
     explicit Inner(Inner const &rhs);
@@ -56,6 +96,10 @@ class Animation {
   virtual void ownershipCheck() const;
   virtual void codeCheck(usize const &anime_code,
                          usize const &motion_code = -1) const;
+  virtual void resizeAnime(usize const &anime_code,
+                           usize const &motion_count);
+  virtual void rebuild(usize const &anime_code);
+  virtual void bakeCheck() const;
 
 }; // Animation
 
@@ -0,0 +1,100 @@
+#ifndef SFML_LIB_ANIMATIONMANAGER_H_
+#define SFML_LIB_ANIMATIONMANAGER_H_
+
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <lib/Animation.h>
+
+using u8 = unsigned char;
+using u32 = unsigned int;
+using usize = unsigned long;
+using f32 = float;
+
+// playback cursors for every animated sprite, each one points into an
+// Animation that stays shared and untouched while instances use it
+class AnimationManager {
+ public:
+  enum PlayMode {
+    kLoop = 0,
+    kPingPong,
+    kOnce, // stops on the last motion
+    kPlayModeCount,
+  };
+
+  static void release();
+
+  // the animation has to outlive its instances and stay unchanged,
+  // speed must not be negative
+  static usize create(Animation const &animation,
+                      usize const &anime_code = 0,
+                      PlayMode const &mode = kLoop,
+                      f32 const &speed = 1.0f);
+  static void destroy(usize const &instance_code);
+  static bool isAlive(usize const &instance_code) noexcept;
+  static usize getInstanceCount() noexcept;
+  static void reserve(usize const &instance_count);
+
+  // restarts from the first motion
+  static void play(usize const &instance_code,
+                   usize const &anime_code,
+                   PlayMode const &mode = kLoop);
+  static void pause(usize const &instance_code);
+  static void resume(usize const &instance_code);
+  static bool isPlaying(usize const &instance_code);
+
+  static usize getAnimeCode(usize const &instance_code);
+  static usize getMotionCode(usize const &instance_code);
+  static void setMotionCode(usize const &instance_code,
+                            usize const &motion_code);
+  static PlayMode getPlayMode(usize const &instance_code);
+  static f32 const &getSpeed(usize const &instance_code);
+  static void setSpeed(usize const &instance_code, f32 const &speed);
+
+  static Motion const &getMotion(usize const &instance_code);
+  static sf::IntRect const &getTextureRect(usize const &instance_code);
+  // needs a baked animation
+  static MotionQuad const &getQuad(usize const &instance_code);
+
+  // every instance, split across the jobs when there are many
+  static void advance(sf::Time const &dt);
+
+ private:
+  AnimationManager() = delete;
+  AnimationManager(AnimationManager const &rhs) = delete;
+  AnimationManager &operator=(AnimationManager const &rhs) = delete;
+  ~AnimationManager() = delete;
+
+  enum {
+    kAdvanceGrain = 2048, // instances a job
+  };
+
+  struct Instance {
+    Motion const *motions_; // into the flat storage of animation_
+    MotionQuad const *quads_; // null unless animation_ is baked
+    Animation const *animation_;
+    sf::Time elapsed_; // from the anime start, wrapped on the cycle
+    sf::Time duration_;
+    f32 speed_;
+    u32 anime_code_;
+    u32 motion_code_;
+    u32 motion_count_;
+    u8 mode_;
+    bool is_playing_;
+  };
+
+  static void codeCheck(usize const &instance_code);
+  static void speedCheck(f32 const &speed);
+  static Instance &getInstance(usize const &instance_code);
+  static void step(Instance &instance, sf::Time const &dt);
+
+  // dense, destroy swaps the last instance into the hole
+  static std::vector<Instance> instances_;
+  static std::vector<usize> instance_codes_;
+  static std::vector<usize> instance_slots_; // code to dense index
+  static std::vector<usize> free_instance_codes_;
+}; // AnimationManager
+
+#endif // SFML_LIB_ANIMATIONMANAGER_H_
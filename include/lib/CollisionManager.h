@@ -0,0 +1,88 @@
+#ifndef SFML_LIB_COLLISIONMANAGER_H_
+#define SFML_LIB_COLLISIONMANAGER_H_
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <lib/ObjectManager.h>
+
+using i32 = int;
+using u32 = unsigned int;
+using u64 = unsigned long long;
+using usize = unsigned long;
+using f32 = float;
+using ColliderPair = std::pair<usize, usize>;
+using ColliderPairs = std::vector<ColliderPair>;
+using ColliderCodes = std::vector<usize>;
+
+// broad phase, a uniform grid hashed by cell with every collider's aabb
+// in each cell it touches, candidates still need a narrow phase check
+class CollisionManager {
+ public:
+  enum {
+    kDefaultCellSize = 128,
+    kMaxCellSpan = 256, // cells a side one aabb may cover
+  };
+
+  static void initialize(f32 const &cell_size = kDefaultCellSize);
+  static void release();
+
+  static f32 const &getCellSize() noexcept;
+  // rehashes every collider
+  static void setCellSize(f32 const &cell_size);
+
+  // bounds must be finite and cover at most kMaxCellSpan cells a side
+  static usize insert(ObjectManager::Handle const &handle,
+                      sf::FloatRect const &bounds);
+  // only touches the grid when the covered cells change
+  static void update(usize const &collider_code, sf::FloatRect const &bounds);
+  static void remove(usize const &collider_code);
+  static bool isAlive(usize const &collider_code) noexcept;
+
+  static ObjectManager::Handle const &getHandle(usize const &collider_code);
+  static sf::FloatRect const &getBounds(usize const &collider_code);
+  static usize getColliderCount() noexcept;
+
+  // overlapping aabbs, each pair once with first < second
+  static void queryPairs(ColliderPairs &pairs);
+  static void queryPoint(sf::Vector2f const &point, ColliderCodes &codes);
+  static void queryRect(sf::FloatRect const &rect, ColliderCodes &codes);
+
+ private:
+  CollisionManager() = delete;
+  CollisionManager(CollisionManager const &rhs) = delete;
+  CollisionManager &operator=(CollisionManager const &rhs) = delete;
+  ~CollisionManager() = delete;
+
+  struct CellRange {
+    i32 left;
+    i32 top;
+    i32 right;
+    i32 bottom;
+  };
+  struct Collider {
+    ObjectManager::Handle handle_;
+    sf::FloatRect bounds_;
+    CellRange cells_;
+    u64 query_stamp_;
+    bool is_alive_;
+  };
+
+  static void codeCheck(usize const &collider_code);
+  static CellRange getCellRange(sf::FloatRect const &bounds);
+  static u64 getCellKey(i32 const &x, i32 const &y) noexcept;
+  static void link(usize const &collider_code);
+  static void unlink(usize const &collider_code);
+
+  static f32 cell_size_;
+  static std::vector<Collider> colliders_;
+  static std::vector<usize> free_codes_;
+  static std::unordered_map<u64, ColliderCodes> cells_;
+  static u64 query_stamp_;
+}; // CollisionManager
+
+#endif // SFML_LIB_COLLISIONMANAGER_H_
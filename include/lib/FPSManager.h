@@ -1,18 +1,51 @@
 #ifndef SFML_LIB_FPSMANAGER_H_
 #define SFML_LIB_FPSMANAGER_H_
 
-#include <list>
+#include <vector>
 #include <SFML/System/Clock.hpp>
 
+using i64 = long long;
 using u64 = unsigned long long;
+using usize = unsigned long;
 
 class FPSManager {
  public:
+  enum PacingMode {
+    kPolling = 0,
+    kHybrid,
+    kPacingModeCount,
+  };
+  struct FrameStats { // us
+    usize sample_count;
+    u64 min;
+    u64 max;
+    u64 mean;
+    u64 p50;
+    u64 p95;
+    u64 p99;
+  };
+
   static u64 getCurrentFPS() noexcept;
 
   static u64 const &getFramerateLimit() noexcept;
   static void setFramerateLimit(u64 const &framerate_limit) noexcept;
 
+  static PacingMode const &getPacingMode() noexcept;
+  static void setPacingMode(PacingMode const &pacing_mode);
+
+  static void calibrateSleep() noexcept;
+  // us, keeps adapting to the sleeps of hybrid frames
+  static u64 const &getSleepGranularity() noexcept;
+  static i64 const &getPacingError() noexcept;
+
+  static usize getHistoryCapacity() noexcept;
+  static void setHistoryCapacity(usize const &history_capacity);
+
+  static usize const &getStatsWindow() noexcept;
+  static void setStatsWindow(usize const &stats_window) noexcept;
+
+  static FrameStats getFrameStats() noexcept;
+
   static void framePulse() noexcept;
 
  private:
@@ -21,8 +54,24 @@ class FPSManager {
   FPSManager &operator=(FPSManager const &rhs) = delete;
   ~FPSManager() = delete;
 
-  static std::list<u64> time_per_frame_;
+  static u64 pollUntil(u64 const &target) noexcept;
+  static u64 sleepSpinUntil(u64 const &target) noexcept;
+
+  static void clearHistory() noexcept;
+  static void pushHistory(u64 const &now) noexcept;
+  static u64 const &getHistory(usize const &age) noexcept;
+
+  static std::vector<u64> time_per_frame_;
+  static std::vector<u64> stats_buffer_;
+  static usize head_;
+  static usize size_;
+  static usize second_count_;
+  static usize stats_window_;
   static sf::Clock clock_;
+  static PacingMode pacing_mode_;
+  static bool is_calibrated_;
+  static u64 sleep_granularity_;
+  static i64 pacing_error_;
   static u64 framerate_limit_;
   static u64 term_;
   static u64 remain_;
@@ -0,0 +1,65 @@
+#ifndef SFML_LIB_INPUTMANAGER_H_
+#define SFML_LIB_INPUTMANAGER_H_
+
+#include <atomic>
+#include <memory>
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/Window/Event.hpp>
+
+using i64 = long long;
+using u64 = unsigned long long;
+using usize = unsigned long;
+
+struct InputEvent {
+  sf::Event event;
+  sf::Time time; // on the input clock when polled
+};
+
+// single producer single consumer ring between the thread polling the
+// window and the simulation tick, neither side ever takes a lock
+class InputManager {
+ public:
+  enum {
+    kQueueCapacity = 1024, // power of two
+  };
+
+  // restarts the input clock and drops whatever is queued, call it while
+  // neither side is running
+  static void initialize();
+  static sf::Time getTime();
+
+  // producer, stamps the event now, false and dropped when full
+  static bool push(sf::Event const &event);
+  static bool push(sf::Event const &event, sf::Time const &time);
+
+  // consumer
+  static bool pop(InputEvent &input_event);
+  // processes every event stamped up to until as part of the tick, which
+  // InputRecorder keeps with the event while it records
+  static usize dispatch(sf::Time const &until, u64 const &tick = 0);
+  // straight to KeyManager or MouseManager, other events are ignored
+  static void process(sf::Event const &event);
+
+  static usize getEventCount() noexcept;
+  static usize getDroppedCount() noexcept;
+  // from capture to dispatch, of the last event dispatched
+  static sf::Time getLatency() noexcept;
+
+ private:
+  InputManager() = delete;
+  InputManager(InputManager const &rhs) = delete;
+  InputManager &operator=(InputManager const &rhs) = delete;
+  ~InputManager() = delete;
+
+  static sf::Clock clock_;
+  static std::unique_ptr<InputEvent[]> events_;
+  // the consumer owns head_, the producer tail_, kept on their own lines
+  alignas(64) static std::atomic<usize> head_;
+  alignas(64) static std::atomic<usize> tail_;
+  alignas(64) static std::atomic<usize> dropped_count_;
+  static std::atomic<i64> latency_; // microseconds
+}; // InputManager
+
+#endif // SFML_LIB_INPUTMANAGER_H_
@@ -0,0 +1,69 @@
+#ifndef SFML_LIB_INPUTRECORDER_H_
+#define SFML_LIB_INPUTRECORDER_H_
+
+#include <string>
+#include <vector>
+
+#include <SFML/Window/Event.hpp>
+
+using u64 = unsigned long long;
+using usize = unsigned long;
+
+// every key and mouse event the tick hands to KeyManager and MouseManager,
+// with the tick number it ran on, played back on the same ticks later
+class InputRecorder {
+ public:
+  enum Mode {
+    kIdle = 0,
+    kRecording,
+    kReplaying,
+    kModeCount,
+  };
+
+  // drops what was recorded or loaded before
+  static void record(u64 const &tick_rate);
+  // from the first event, the ticks count from 0 again
+  static void replay();
+  static void stop() noexcept;
+  static Mode const &getMode() noexcept;
+  static bool isRecording() noexcept;
+  static bool isReplaying() noexcept;
+  // replaying, every event fed and as many ticks run as the session had
+  static bool isFinished() noexcept;
+
+  // tick rate of the session, replays only line up at the same one
+  static u64 const &getTickRate() noexcept;
+  // ticks the session ran, idle ones after the last event included, set
+  // it before saving a recording
+  static u64 const &getTickCount() noexcept;
+  static void setTickCount(u64 const &tick_count) noexcept;
+  static usize getEventCount() noexcept;
+
+  // ignored unless recording
+  static void capture(u64 const &tick, sf::Event const &event);
+  // processes every event recorded for the tick, returns how many
+  static usize feed(u64 const &tick);
+
+  static void loadFromFile(std::string const &filename);
+  static void saveToFile(std::string const &filename);
+
+ private:
+  InputRecorder() = delete;
+  InputRecorder(InputRecorder const &rhs) = delete;
+  InputRecorder &operator=(InputRecorder const &rhs) = delete;
+  ~InputRecorder() = delete;
+
+  struct Record {
+    u64 tick_;
+    sf::Event event_;
+  };
+
+  static Mode mode_;
+  static u64 tick_rate_;
+  static u64 tick_count_;
+  static u64 fed_tick_count_; // ticks feed has run for this replay
+  static std::vector<Record> records_;
+  static usize cursor_;
+}; // InputRecorder
+
+#endif // SFML_LIB_INPUTRECORDER_H_
@@ -0,0 +1,89 @@
+#ifndef SFML_LIB_JOBMANAGER_H_
+#define SFML_LIB_JOBMANAGER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using i64 = long long;
+using usize = unsigned long;
+using Job = std::function<void()>;
+using RangeJob = std::function<void(usize const &, usize const &)>;
+using JobCounter = std::atomic<usize>;
+
+// work stealing scheduler, each worker owns a lock free deque and steals
+// from the others when it runs dry, the thread calling initialize is
+// worker 0 and only helps while it waits
+class JobManager {
+ public:
+  enum {
+    kDequeCapacity = 4096, // power of two, a full deque runs jobs inline
+    kSpinCount = 64,
+  };
+
+  // 0 picks hardware_concurrency - 1 extra workers
+  static void initialize(usize const &worker_count = 0);
+  static void release();
+  static bool isRunning() noexcept;
+
+  // worker 0 included
+  static usize getWorkerCount() noexcept;
+
+  // counter goes up now and down when the job ends, may be null, a job
+  // throwing on a worker ends the program, parallelFor catches its own
+  static void run(Job const &job, JobCounter *const &counter = nullptr);
+  // runs other jobs until the counter drops to 0
+  static void wait(JobCounter const &counter);
+
+  // splits [begin, end) into chunks of grain, 0 picks about four chunks
+  // a worker, returns once every chunk has run, inline when not running,
+  // rethrows the first exception a chunk threw
+  static void parallelFor(usize const &begin,
+                          usize const &end,
+                          usize const &grain,
+                          RangeJob const &job);
+
+ private:
+  JobManager() = delete;
+  JobManager(JobManager const &rhs) = delete;
+  JobManager &operator=(JobManager const &rhs) = delete;
+  ~JobManager() = delete;
+
+  struct Task {
+    Job job_;
+    JobCounter *counter_;
+  };
+  // chase lev, the owner pushes and pops the bottom, thieves take the top
+  class Deque {
+   public:
+    explicit Deque();
+
+    virtual bool push(Task *const &task);
+    virtual Task *pop();
+    virtual Task *steal();
+
+   private:
+    std::atomic<i64> top_;
+    std::atomic<i64> bottom_;
+    std::unique_ptr<std::atomic<Task *>[]> tasks_;
+  };
+
+  static void workerLoop(usize const &worker_code);
+  static Task *findTask(usize const &worker_code);
+  static void execute(Task *const &task);
+
+  static std::vector<std::unique_ptr<Deque>> deques_;
+  static std::vector<std::thread> workers_;
+  static std::atomic<usize> pending_; // queued, not yet taken
+  static std::atomic<usize> sleeping_;
+  static std::atomic<bool> is_running_;
+  static std::mutex mutex_;
+  static std::condition_variable condition_;
+  static thread_local usize worker_code_;
+}; // JobManager
+
+#endif // SFML_LIB_JOBMANAGER_H_
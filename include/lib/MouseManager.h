@@ -5,6 +5,7 @@
 #include <utility>
 #include <vector>
 
+#include <SFML/System/Vector2.hpp>
 #include <SFML/Window/Event.hpp>
 
 using i32 = int;
@@ -89,8 +90,13 @@ class MouseManager {
   static void eventProcess(sf::Event const &event);
   static void framework();
   static void framework(sf::WindowBase const &relativeTo);
+  // pressed callbacks get position instead of the device's, so a replay
+  // does not depend on where the real cursor is
+  static void framework(sf::Vector2i const &position);
 
   static bool getIsEntered() noexcept;
+  // where the last move, button or scroll event happened
+  static sf::Vector2i const &getPosition() noexcept;
 
   static ButtonMap const *const &getButtonMap() noexcept;
   static void setButtonMap(ButtonMap const *const &button_map);
@@ -125,6 +131,7 @@ class MouseManager {
   static void codeCheck(usize const &mouse_event_code);
 
   static bool is_entered_;
+  static sf::Vector2i position_;
   static ButtonMap const *button_map_;
   static std::vector<bool> button_state_;
   static std::vector<ButtonCallback> mouse_event_callbacks_;
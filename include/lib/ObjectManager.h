@@ -0,0 +1,80 @@
+#ifndef SFML_LIB_OBJECTMANAGER_H_
+#define SFML_LIB_OBJECTMANAGER_H_
+
+#include <vector>
+
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/System/Vector2.hpp>
+
+using u32 = unsigned int;
+using usize = unsigned long;
+using f32 = float;
+
+// transforms of every object in parallel dense arrays, destroy swaps
+// the last object into the hole so passes can walk [0, getObjectCount())
+class ObjectManager {
+ public:
+  struct Handle {
+    u32 slot;
+    u32 generation; // 0 is never alive
+  };
+
+  static Handle create();
+  static Handle create(sf::Vector2f const &position,
+                       f32 const &z_depth = 0.0f);
+  static void destroy(Handle const &handle);
+  static bool isAlive(Handle const &handle) noexcept;
+  static void clear() noexcept;
+  static void reserve(usize const &capacity);
+
+  static usize getObjectCount() noexcept;
+  // dense index, moves when another object is destroyed
+  static usize getIndex(Handle const &handle);
+  static Handle const &getHandle(usize const &index);
+
+  // arrays indexed by dense index, invalidated by create
+  static std::vector<sf::Vector2f> &getPositions() noexcept;
+  static std::vector<f32> &getZDepths() noexcept;
+  static std::vector<f32> &getRotations() noexcept;
+  static std::vector<sf::Vector2f> &getScales() noexcept;
+  static std::vector<sf::Vector2f> &getOrigins() noexcept;
+
+  static sf::Vector2f const &getPosition(Handle const &handle);
+  static f32 const &getZDepth(Handle const &handle);
+  static f32 const &getRotation(Handle const &handle);
+  static sf::Vector2f const &getScale(Handle const &handle);
+  static sf::Vector2f const &getOrigin(Handle const &handle);
+  static void setPosition(Handle const &handle, sf::Vector2f const &position);
+  static void setZDepth(Handle const &handle, f32 const &z_depth);
+  static void setRotation(Handle const &handle, f32 const &angle);
+  static void setScale(Handle const &handle, sf::Vector2f const &factor);
+  static void setOrigin(Handle const &handle, sf::Vector2f const &origin);
+
+  static sf::Transform getTransform(usize const &index);
+  static sf::Transform getTransform(Handle const &handle);
+
+ private:
+  ObjectManager() = delete;
+  ObjectManager(ObjectManager const &rhs) = delete;
+  ObjectManager &operator=(ObjectManager const &rhs) = delete;
+  ~ObjectManager() = delete;
+
+  struct Slot {
+    u32 index;
+    u32 generation;
+  };
+
+  static void handleCheck(Handle const &handle);
+
+  static std::vector<sf::Vector2f> positions_;
+  static std::vector<f32> z_depths_;
+  static std::vector<f32> rotations_;
+  static std::vector<sf::Vector2f> scales_;
+  static std::vector<sf::Vector2f> origins_;
+  static std::vector<Handle> handles_;
+
+  static std::vector<Slot> slots_;
+  static std::vector<u32> free_slots_;
+}; // ObjectManager
+
+#endif // SFML_LIB_OBJECTMANAGER_H_
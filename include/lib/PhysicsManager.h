@@ -0,0 +1,129 @@
+#ifndef SFML_LIB_PHYSICSMANAGER_H_
+#define SFML_LIB_PHYSICSMANAGER_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <lib/ObjectManager.h>
+
+using i32 = int;
+using u8 = unsigned char;
+using u32 = unsigned int;
+using usize = unsigned long;
+using f32 = float;
+
+// platformer physics on the fixed tick, bodies stand on one way footholds
+// and stop at vertical ones (walls), the object position is the foot point
+class PhysicsManager {
+ public:
+  enum BodyState {
+    kAir = 0,
+    kGround,
+    kLadder,
+    kBodyStateCount,
+  };
+  struct Foothold {
+    sf::Vector2f from; // left end, top end for walls
+    sf::Vector2f to;
+    usize prev; // footholds sharing an end, -1 for none
+    usize next;
+    bool is_wall;
+  };
+  struct Ladder {
+    f32 x;
+    f32 top;
+    f32 bottom;
+  };
+
+  static void initialize();
+  static void release();
+
+  static f32 const &getGravity() noexcept;
+  static void setGravity(f32 const &gravity) noexcept;
+  static f32 const &getTerminalVelocity() noexcept;
+  static void setTerminalVelocity(f32 const &terminal_velocity) noexcept;
+
+  // terrain, footholds meeting at an end are walked across
+  static usize addFoothold(sf::Vector2f const &from, sf::Vector2f const &to);
+  static usize addLadder(f32 const &x, f32 const &top, f32 const &bottom);
+  static void clearTerrain();
+  static usize getFootholdCount() noexcept;
+  static Foothold const &getFoothold(usize const &foothold_code);
+  static usize getLadderCount() noexcept;
+  static Ladder const &getLadder(usize const &ladder_code);
+
+  static usize createBody(ObjectManager::Handle const &handle,
+                          sf::Vector2f const &size);
+  static void destroyBody(usize const &body_code);
+  static bool isAlive(usize const &body_code) noexcept;
+  static usize getBodyCount() noexcept;
+  static void reserve(usize const &body_count);
+
+  static ObjectManager::Handle const &getHandle(usize const &body_code);
+  static sf::Vector2f const &getSize(usize const &body_code);
+  static void setSize(usize const &body_code, sf::Vector2f const &size);
+  static sf::Vector2f const &getVelocity(usize const &body_code);
+  static void setVelocity(usize const &body_code,
+                          sf::Vector2f const &velocity);
+  static BodyState getState(usize const &body_code);
+  // -1 unless standing
+  static usize getStandingFoothold(usize const &body_code);
+
+  // horizontal speed on the ground and in the air, ignored on a ladder
+  static void walk(usize const &body_code, f32 const &speed);
+  // from the ground or a ladder only
+  static bool jump(usize const &body_code, f32 const &speed);
+  // attaches to a ladder the body overlaps
+  static bool grabLadder(usize const &body_code);
+  // vertical speed on a ladder, negative is up
+  static void climb(usize const &body_code, f32 const &speed);
+
+  static void step(sf::Time const &dt);
+
+ private:
+  PhysicsManager() = delete;
+  PhysicsManager(PhysicsManager const &rhs) = delete;
+  PhysicsManager &operator=(PhysicsManager const &rhs) = delete;
+  ~PhysicsManager() = delete;
+
+  enum {
+    kColumnWidth = 256,
+    kStepGrain = 512, // bodies a job
+  };
+
+  static void codeCheck(usize const &body_code);
+  static i32 getColumn(f32 const &x) noexcept;
+  static f32 getHeight(Foothold const &foothold, f32 const &x) noexcept;
+  static f32 sweepWalls(sf::FloatRect const &box,
+                        f32 const &dx,
+                        f32 const &dy);
+  static usize sweepFloors(sf::Vector2f const &feet,
+                           sf::Vector2f const &displacement,
+                           f32 &t);
+  static void stepGround(usize const &index, sf::Vector2f &position, f32 dt);
+  static void stepLadder(usize const &index, sf::Vector2f &position, f32 dt);
+  static void stepAir(usize const &index, sf::Vector2f &position, f32 dt);
+
+  static f32 gravity_;
+  static f32 terminal_velocity_;
+
+  static std::vector<Foothold> footholds_;
+  static std::vector<Ladder> ladders_;
+  static std::unordered_map<i32, std::vector<usize>> columns_;
+
+  // dense, destroy swaps the last body into the hole
+  static std::vector<ObjectManager::Handle> body_handles_;
+  static std::vector<sf::Vector2f> body_sizes_;
+  static std::vector<sf::Vector2f> body_velocities_;
+  static std::vector<u8> body_states_;
+  static std::vector<usize> body_supports_; // foothold or ladder code
+  static std::vector<usize> body_codes_;
+  static std::vector<usize> body_slots_; // code to dense index
+  static std::vector<usize> free_body_codes_;
+}; // PhysicsManager
+
+#endif // SFML_LIB_PHYSICSMANAGER_H_
@@ -0,0 +1,91 @@
+#ifndef SFML_LIB_RECTPACKER_H_
+#define SFML_LIB_RECTPACKER_H_
+
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+
+using i32 = int;
+using u32 = unsigned int;
+using usize = unsigned long;
+
+class RectPacker {
+ public:
+  enum Method {
+    kMaxRects = 0,
+    kSkyline,
+    kMethodCount,
+  };
+  struct Placement {
+    sf::IntRect rect;
+    bool is_rotated;
+  };
+
+  explicit RectPacker();
+  explicit RectPacker(usize const &width,
+                      usize const &height,
+                      Method const &method = kMaxRects,
+                      bool const &allow_rotation = false);
+  explicit RectPacker(RectPacker const &rhs) noexcept;
+  virtual RectPacker &operator=(RectPacker const &rhs) noexcept;
+  virtual ~RectPacker() noexcept;
+
+  virtual RectPacker clone() const;
+
+  virtual void create(usize const &width, usize const &height);
+
+  virtual sf::Vector2u getSize() const;
+  virtual sf::Vector2u getUsedSize() const;
+  virtual usize getUsedArea() const;
+
+  virtual Method const &getMethod() const;
+  virtual void setMethod(Method const &method);
+
+  virtual bool const &getAllowRotation() const;
+  virtual void setAllowRotation(bool const &allow_rotation);
+
+  virtual bool insert(usize const &width,
+                      usize const &height,
+                      Placement &placement);
+
+ protected:
+  struct SkylineNode {
+    i32 x;
+    i32 y;
+    i32 width;
+  };
+  struct Inner {
+    i32 width_;
+    i32 height_;
+    Method method_;
+    bool allow_rotation_;
+    usize used_area_;
+    sf::Vector2u used_size_;
+    std::vector<sf::IntRect> free_rects_;
+    std::vector<SkylineNode> skyline_;
+
+    explicit Inner();
+    explicit Inner(Inner const &rhs);
+    virtual Inner &operator=(Inner const &rhs);
+  } *ownership;
+
+ private:
+  explicit RectPacker(RectPacker::Inner *const &ownership) noexcept;
+  virtual void ownershipCheck() const;
+
+  virtual bool findMaxRects(i32 const &width,
+                            i32 const &height,
+                            Placement &placement) const;
+  virtual void placeMaxRects(sf::IntRect const &rect);
+  virtual bool findSkyline(i32 const &width,
+                           i32 const &height,
+                           Placement &placement,
+                           usize &node_code) const;
+  virtual void placeSkyline(sf::IntRect const &rect, usize const &node_code);
+  virtual i32 fitSkyline(usize const &node_code,
+                         i32 const &width,
+                         i32 const &height) const;
+
+}; // RectPacker
+
+#endif // SFML_LIB_RECTPACKER_H_
@@ -0,0 +1,177 @@
+#ifndef SFML_LIB_RESOURCEMANAGER_H_
+#define SFML_LIB_RESOURCEMANAGER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <lib/WrapImage.h>
+#include <lib/WrapSoundBuffer.h>
+#include <lib/WrapTexture.h>
+
+using u64 = unsigned long long;
+using usize = unsigned long;
+using ImageProcess = std::function<void(WrapImage &)>;
+
+class ResourceHandle;
+
+// loads are deduplicated by type and path, so an ImageProcess or
+// SoundBufferOptions only applies to the first load of a path
+class ResourceManager {
+ public:
+  enum ResourceType {
+    kImage = 0,
+    kTexture,
+    kSoundBuffer,
+    kFont,
+    kResourceTypeCount,
+  };
+  enum ResourceState {
+    kQueued = 0,
+    kDecoded, // waiting for upload
+    kReady,
+    kFailed,
+    kResourceStateCount,
+  };
+  struct MemoryStats {
+    usize resource_count;
+    usize referenced_count;
+    usize memory_usage; // bytes
+  };
+
+  static void initialize(usize const &worker_count = 0);
+  static void release();
+
+  static ResourceHandle loadImage(std::string const &filename,
+                                  ImageProcess const &process = ImageProcess());
+  static ResourceHandle loadTexture(std::string const &filename,
+                                    ImageProcess const &process =
+                                        ImageProcess());
+  static ResourceHandle loadSoundBuffer(std::string const &filename,
+                                        SoundBufferOptions const &options =
+                                            SoundBufferOptions());
+  static ResourceHandle loadFont(std::string const &filename);
+
+  static void uploadPending(sf::Time const &budget);
+
+  static ResourceState getState(usize const &resource_code);
+  static bool isReady(usize const &resource_code);
+  static std::string const &getError(usize const &resource_code);
+  static usize getPendingCount();
+
+  static WrapImage const &getImage(usize const &resource_code);
+  static WrapTexture const &getTexture(usize const &resource_code);
+  static WrapSoundBuffer const &getSoundBuffer(usize const &resource_code);
+  static sf::Font const &getFont(usize const &resource_code);
+
+  static usize getReferenceCount(usize const &resource_code);
+  static MemoryStats getMemoryStats(ResourceType const &type);
+  static usize getMemoryUsage();
+
+  // 0 means unlimited, unreferenced resources are evicted past it
+  static usize getMemoryBudget();
+  static void setMemoryBudget(usize const &memory_budget);
+
+ private:
+  ResourceManager() = delete;
+  ResourceManager(ResourceManager const &rhs) = delete;
+  ResourceManager &operator=(ResourceManager const &rhs) = delete;
+  ~ResourceManager() = delete;
+
+  friend class ResourceHandle;
+
+  struct Entry {
+    ResourceType type_;
+    std::string filename_;
+    ImageProcess process_;
+    SoundBufferOptions sound_options_;
+    std::atomic<ResourceState> state_;
+    std::string error_;
+    WrapImage image_;
+    WrapTexture texture_;
+    WrapSoundBuffer sound_buffer_;
+    sf::Font font_;
+    usize reference_count_;
+    usize memory_usage_;
+    u64 last_use_;
+
+    explicit Entry(ResourceType const &type,
+                   std::string const &filename,
+                   ImageProcess const &process,
+                   SoundBufferOptions const &sound_options);
+  };
+
+  static ResourceHandle enqueue(ResourceType const &type,
+                                std::string const &filename,
+                                ImageProcess const &process = ImageProcess(),
+                                SoundBufferOptions const &sound_options =
+                                    SoundBufferOptions());
+  static void work();
+  static ResourceState decode(Entry &entry);
+  static void finish(usize const &resource_code,
+                     ResourceState const &state);
+  static void evict();
+  static void erase(usize const &resource_code);
+  static void retain(usize const &resource_code) noexcept;
+  static void drop(usize const &resource_code) noexcept;
+  static Entry &readyCheck(usize const &resource_code,
+                           ResourceType const &type);
+  static Entry &getEntry(usize const &resource_code);
+
+  static std::vector<std::unique_ptr<Entry>> entries_;
+  static std::vector<usize> free_codes_;
+  static std::map<std::pair<ResourceType, std::string>, usize> codes_;
+  static std::deque<usize> decode_queue_;
+  static std::deque<usize> upload_queue_;
+  static std::vector<std::thread> workers_;
+  static std::mutex mutex_;
+  static std::condition_variable condition_;
+  static usize pending_count_;
+  static bool is_running_;
+  static u64 use_clock_;
+  static usize memory_budget_;
+  static usize memory_usage_;
+  static usize type_memory_usage_[kResourceTypeCount];
+}; // ResourceManager
+
+// shared reference to a cached resource, copies only touch the count
+class ResourceHandle {
+ public:
+  explicit ResourceHandle() noexcept;
+  ResourceHandle(ResourceHandle const &rhs) noexcept;
+  virtual ResourceHandle &operator=(ResourceHandle const &rhs) noexcept;
+  virtual ~ResourceHandle() noexcept;
+
+  virtual usize const &getCode() const noexcept;
+  virtual bool isNull() const noexcept;
+
+  virtual ResourceManager::ResourceState getState() const;
+  virtual bool isReady() const;
+  virtual std::string const &getError() const;
+
+  virtual WrapImage const &getImage() const;
+  virtual WrapTexture const &getTexture() const;
+  virtual WrapSoundBuffer const &getSoundBuffer() const;
+  virtual sf::Font const &getFont() const;
+
+ private:
+  friend class ResourceManager;
+
+  // adopts a reference already counted by ResourceManager
+  explicit ResourceHandle(usize const &resource_code) noexcept;
+
+  usize resource_code_;
+}; // ResourceHandle
+
+#endif // SFML_LIB_RESOURCEMANAGER_H_
@@ -0,0 +1,107 @@
+#ifndef SFML_LIB_SOUNDMANAGER_H_
+#define SFML_LIB_SOUNDMANAGER_H_
+
+#include <vector>
+
+#include <SFML/Audio/Sound.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <lib/WrapSoundBuffer.h>
+
+using i32 = int;
+using u64 = unsigned long long;
+using usize = unsigned long;
+using f32 = float;
+
+// fixed pool of preallocated voices shared by every sound effect
+class SoundManager {
+ public:
+  enum {
+    kDefaultVoiceCount = 32,
+    kDefaultMaxVoice = 4,
+    kDecodedLifetime = 600, // frames a compressed sound stays decoded idle
+    kDefaultAudibleRange = 800,
+  };
+
+  static void initialize(usize const &voice_count = kDefaultVoiceCount);
+  static void release();
+
+  // the buffer has to outlive the registration
+  static usize registerSound(WrapSoundBuffer const &sound_buffer,
+                             usize const &max_voice = kDefaultMaxVoice,
+                             i32 const &priority = 0);
+
+  static usize const &getMaxVoice(usize const &sound_code);
+  static void setMaxVoice(usize const &sound_code, usize const &max_voice);
+
+  static i32 const &getPriority(usize const &sound_code);
+  static void setPriority(usize const &sound_code, i32 const &priority);
+
+  // returns the voice code, or -1 when deduplicated or out of voices
+  static usize play(usize const &sound_code,
+                    f32 const &volume = 100.0f,
+                    f32 const &pitch = 1.0f);
+  // positional, culled without taking a voice beyond audible_range
+  static usize playAt(usize const &sound_code,
+                      sf::Vector2f const &position,
+                      f32 const &audible_range = kDefaultAudibleRange,
+                      f32 const &volume = 100.0f,
+                      f32 const &pitch = 1.0f);
+  static void stop(usize const &sound_code);
+  static void stopAll();
+
+  // once per frame, identical triggers inside a frame play once and
+  // compressed sounds idle for kDecodedLifetime frames drop their pcm
+  static void framework();
+
+  static sf::Vector2f const &getListenerPosition() noexcept;
+  static void setListenerPosition(sf::Vector2f const &position) noexcept;
+  // 1 next to the listener, 0 at audible_range and beyond
+  static f32 getAttenuation(sf::Vector2f const &position,
+                            f32 const &audible_range);
+
+  static usize getVoiceCount() noexcept;
+  static usize getActiveVoiceCount();
+  static usize getActiveVoiceCount(usize const &sound_code);
+
+ private:
+  SoundManager() = delete;
+  SoundManager(SoundManager const &rhs) = delete;
+  SoundManager &operator=(SoundManager const &rhs) = delete;
+  ~SoundManager() = delete;
+
+  struct Sound {
+    WrapSoundBuffer const *sound_buffer_;
+    usize max_voice_;
+    i32 priority_;
+    u64 trigger_frame_;
+    u64 active_frame_;
+    usize trigger_voice_;
+  };
+  struct Voice {
+    sf::Sound sound_;
+    usize sound_code_;
+    i32 priority_;
+    u64 start_;
+    f32 volume_;
+    bool is_positional_;
+    sf::Vector2f position_;
+    f32 audible_range_;
+  };
+
+  static void codeCheck(usize const &sound_code);
+  static bool isActive(Voice const &voice);
+  static usize findVoice(usize const &sound_code);
+  static usize start(usize const &sound_code,
+                     f32 const &volume,
+                     f32 const &pitch);
+  static f32 spatialize(Voice &voice);
+
+  static std::vector<Sound> sounds_;
+  static std::vector<Voice> voices_;
+  static u64 frame_;
+  static u64 start_clock_;
+  static sf::Vector2f listener_position_;
+}; // SoundManager
+
+#endif // SFML_LIB_SOUNDMANAGER_H_
@@ -0,0 +1,80 @@
+#ifndef SFML_LIB_SPRITEATLAS_H_
+#define SFML_LIB_SPRITEATLAS_H_
+
+#include <string>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <lib/Animation.h>
+#include <lib/WrapImage.h>
+#include <lib/WrapTexture.h>
+
+using usize = unsigned long;
+using WrapImages = std::vector<WrapImage>;
+using WrapTextures = std::vector<WrapTexture>;
+
+struct AtlasFrame {
+  usize page;
+  sf::IntRect rect;
+  bool is_rotated;
+  sf::Vector2f origin;
+  sf::Time duration;
+};
+using AtlasFrames = std::vector<AtlasFrame>;
+using AtlasFramesStore = std::vector<AtlasFrames>;
+
+// index file: "<name>.atlas", pages: "<name>.<page>.png" next to it
+class SpriteAtlas {
+ public:
+  explicit SpriteAtlas();
+  explicit SpriteAtlas(std::string const &filename);
+  explicit SpriteAtlas(SpriteAtlas const &rhs) noexcept;
+  virtual SpriteAtlas &operator=(SpriteAtlas const &rhs) noexcept;
+  virtual ~SpriteAtlas() noexcept;
+
+  virtual SpriteAtlas clone() const;
+
+  virtual void create(WrapImages const &pages,
+                      std::vector<std::string> const &names,
+                      AtlasFramesStore const &frames_store);
+
+  virtual void loadFromFile(std::string const &filename);
+  virtual void saveToFile(std::string const &filename) const;
+
+  virtual usize getPageCount() const;
+  virtual WrapTexture const &getTexture(usize const &page_code) const;
+
+  virtual usize getAnimeCount() const;
+  virtual usize getAnimeCode(std::string const &name) const;
+  virtual std::string const &getAnimeName(usize const &anime_code) const;
+
+  virtual AtlasFrames const &getFrames(usize const &anime_code) const;
+  virtual AtlasFrame const &getFrame(usize const &anime_code,
+                                     usize const &frame_code) const;
+
+  // throws on rotated frames, draw those through SpriteBatch
+  virtual Animation generateAnimation() const;
+
+ protected:
+  struct Inner {
+    WrapImages images_;
+    WrapTextures textures_;
+    std::vector<std::string> names_;
+    AtlasFramesStore frames_store_;
+
+    explicit Inner();
+    explicit Inner(Inner const &rhs);
+    virtual Inner &operator=(Inner const &rhs);
+  } *ownership;
+
+ private:
+  explicit SpriteAtlas(SpriteAtlas::Inner *const &ownership) noexcept;
+  virtual void ownershipCheck() const;
+  virtual void codeCheck(usize const &anime_code,
+                         usize const &frame_code = -1) const;
+
+}; // SpriteAtlas
+
+#endif // SFML_LIB_SPRITEATLAS_H_
@@ -0,0 +1,120 @@
+#ifndef SFML_LIB_SPRITEBATCH_H_
+#define SFML_LIB_SPRITEBATCH_H_
+
+#include <utility>
+#include <vector>
+
+#include <SFML/Graphics.hpp>
+
+#include <lib/Animation.h>
+#include <lib/SpriteAtlas.h>
+
+using u32 = unsigned int;
+using usize = unsigned long;
+using f32 = float;
+
+// collects textured quads for a frame, orders them by layer, z depth then
+// texture and draws each run sharing a texture as one vertex array
+class SpriteBatch {
+ public:
+  enum Layer {
+    kBackground = 0,
+    kTerrain,
+    kMob,
+    kPlayer,
+    kEffect,
+    kInterface,
+    kLayerCount,
+  };
+
+  explicit SpriteBatch();
+  explicit SpriteBatch(SpriteBatch const &rhs) noexcept;
+  virtual SpriteBatch &operator=(SpriteBatch const &rhs) noexcept;
+  virtual ~SpriteBatch() noexcept;
+
+  virtual SpriteBatch clone() const;
+
+  virtual void clear();
+  virtual void reserve(usize const &sprite_count);
+
+  // texture may be null for a plain colored quad
+  virtual void draw(sf::Texture const *const &texture,
+                    sf::IntRect const &texture_rect,
+                    sf::Vector2f const &size,
+                    sf::Transform const &transform,
+                    Layer const &layer,
+                    f32 const &z_depth,
+                    sf::Color const &color = sf::Color::White);
+  virtual void draw(sf::Sprite const &sprite,
+                    Layer const &layer,
+                    f32 const &z_depth);
+  virtual void draw(sf::RectangleShape const &shape,
+                    Layer const &layer,
+                    f32 const &z_depth);
+  // rotated frames are turned back, the transform works in frame pixels
+  virtual void draw(SpriteAtlas const &atlas,
+                    AtlasFrame const &frame,
+                    sf::Transform const &transform,
+                    Layer const &layer,
+                    f32 const &z_depth,
+                    sf::Color const &color = sf::Color::White);
+
+  // baked quad, only the transform and the color are left to apply
+  virtual void draw(sf::Texture const *const &texture,
+                    MotionQuad const &quad,
+                    sf::Transform const &transform,
+                    Layer const &layer,
+                    f32 const &z_depth,
+                    sf::Color const &color = sf::Color::White);
+
+  virtual void render(sf::RenderTarget &target,
+                      sf::RenderStates const &states =
+                          sf::RenderStates::Default);
+
+  virtual usize getSpriteCount() const;
+  // draw calls the last render issued
+  virtual usize getDrawCallCount() const;
+
+ protected:
+  // layer:4 | z depth:16 | texture:12, ties keep submission order
+  struct Item {
+    u32 key_;
+    sf::Texture const *texture_;
+    sf::Vertex vertices_[4];
+  };
+  struct SortEntry {
+    u32 key_;
+    u32 item_code_;
+  };
+  struct Batch {
+    sf::Texture const *texture_;
+    sf::VertexArray vertices_;
+  };
+  struct Inner {
+    std::vector<Item> items_;
+    std::vector<SortEntry> order_;
+    std::vector<SortEntry> swap_order_;
+    // a frame sees few textures, a linear scan beats hashing and clear
+    // keeps the capacity
+    std::vector<std::pair<sf::Texture const *, u32>> texture_codes_;
+    std::vector<Batch> batches_;
+    usize batch_count_;
+    bool is_built_;
+
+    explicit Inner();
+    explicit Inner(Inner const &rhs);
+    virtual Inner &operator=(Inner const &rhs);
+  } *ownership;
+
+ private:
+  explicit SpriteBatch(SpriteBatch::Inner *const &ownership) noexcept;
+  virtual void ownershipCheck() const;
+  virtual u32 makeKey(sf::Texture const *const &texture,
+                      Layer const &layer,
+                      f32 const &z_depth);
+  virtual void sort();
+  virtual void build();
+
+}; // SpriteBatch
+
+#endif // SFML_LIB_SPRITEBATCH_H_
@@ -1,8 +1,11 @@
 #ifndef SFML_LIB_SPRITEGENERATOR_H_
 #define SFML_LIB_SPRITEGENERATOR_H_
 
+#include <string>
 #include <vector>
 
+#include <lib/Animation.h>
+#include <lib/RectPacker.h>
 #include <lib/WrapImage.h>
 #include <lib/WrapTexture.h>
 
@@ -11,6 +14,25 @@ using f32 = float;
 using usize = unsigned long;
 using WrapImages = std::vector<WrapImage>;
 using WrapImagesStore = std::vector<WrapImages>;
+using WrapTextures = std::vector<WrapTexture>;
+using Durations = std::vector<sf::Time>;
+using DurationsStore = std::vector<Durations>;
+
+struct AtlasOptions {
+  RectPacker::Method method = RectPacker::kMaxRects;
+  bool allow_rotation = false; // rotated regions are turned 90 clockwise
+  bool power_of_two = false;
+  usize padding = 0;
+  usize extrusion = 0;
+  usize max_size = 0;          // 0: sf::Texture::getMaximumSize()
+};
+struct AtlasRegion {
+  usize page;
+  sf::IntRect rect;
+  bool is_rotated;
+};
+using AtlasRegions = std::vector<AtlasRegion>;
+using AtlasRegionsStore = std::vector<AtlasRegions>;
 
 class SpriteGenerator {
  public:
@@ -24,6 +46,18 @@ class SpriteGenerator {
   virtual SpriteGenerator clone() const;
 
   virtual WrapTexture generateSpriteSheet() const;
+  virtual WrapImage generateSpriteSheetImage() const;
+  virtual Animation generateAnimation(
+      WrapTexture &sprite_sheet,
+      DurationsStore const &durations_store) const;
+  virtual Animation generateAnimation(WrapTexture &sprite_sheet,
+                                      sf::Time const &duration) const;
+  virtual WrapTextures generateAtlas(
+      AtlasRegionsStore &regions_store,
+      AtlasOptions const &options = AtlasOptions()) const;
+  virtual WrapImages generateAtlasImages(
+      AtlasRegionsStore &regions_store,
+      AtlasOptions const &options = AtlasOptions()) const;
 
   virtual WrapImagesStore const &getImagesStore() const;
   virtual void setImagesStore(WrapImagesStore const &images_store);
@@ -51,6 +85,9 @@ class SpriteGenerator {
                              WrapImage const &image);
   virtual WrapImage popBackImage(usize const &images_code);
 
+  virtual void loadImagesFromDirectory(usize const &images_code,
+                                       std::string const &directory);
+
   virtual void create(usize const &width,
                       usize const &height,
                       sf::Color const &color = sf::Color(0, 0, 0));
@@ -78,6 +115,11 @@ class SpriteGenerator {
   virtual void ownershipCheck() const;
   virtual void codeCheck(usize const &images_code,
                          usize const &image_code = -1) const;
+  virtual sf::Vector2u layoutSpriteSheet(
+      std::vector<std::vector<sf::IntRect>> &animes) const;
+  virtual WrapImage composeSpriteSheet(
+      std::vector<std::vector<sf::IntRect>> const &animes,
+      sf::Vector2u const &size) const;
 
 }; // SpriteGenerator
 
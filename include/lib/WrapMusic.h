@@ -0,0 +1,102 @@
+#ifndef SFML_LIB_WRAPMUSIC_H_
+#define SFML_LIB_WRAPMUSIC_H_
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <SFML/Audio/InputSoundFile.hpp>
+#include <SFML/Audio/SoundStream.hpp>
+#include <SFML/System/Time.hpp>
+
+using usize = unsigned long;
+using f32 = float;
+
+// streams from disk in small chunks on the sound stream thread,
+// loops without a gap and crossfades through update()
+class WrapMusic {
+ public:
+  explicit WrapMusic();
+  explicit WrapMusic(std::string const &filename);
+  explicit WrapMusic(WrapMusic const &rhs) noexcept;
+  virtual WrapMusic &operator=(WrapMusic const &rhs) noexcept;
+  virtual ~WrapMusic() noexcept;
+
+  virtual WrapMusic clone() const;
+
+  virtual void openFromFile(std::string const &filename);
+
+  virtual void play();
+  virtual void pause();
+  virtual void stop();
+  virtual sf::SoundSource::Status getStatus() const;
+
+  virtual bool getLoop() const;
+  virtual void setLoop(bool const &is_loop);
+
+  virtual f32 const &getVolume() const;
+  virtual void setVolume(f32 const &volume);
+
+  virtual sf::Time getDuration() const;
+  virtual sf::Time getPlayingOffset() const;
+  virtual void setPlayingOffset(sf::Time const &offset);
+
+  // gain is applied on top of volume, 0 to 1
+  virtual f32 const &getGain() const;
+  virtual void fade(f32 const &gain,
+                    sf::Time const &duration,
+                    bool const &stop_after = false);
+  virtual void crossfade(WrapMusic &next, sf::Time const &duration);
+  virtual bool isFading() const;
+
+  virtual void update(sf::Time const &dt);
+
+ protected:
+  class Stream : public sf::SoundStream {
+   public:
+    explicit Stream();
+    virtual ~Stream();
+
+    virtual void openFromFile(std::string const &filename);
+    virtual sf::Time getDuration() const;
+
+    virtual bool getLoop() const;
+    virtual void setLoop(bool const &is_loop);
+
+   protected:
+    virtual bool onGetData(sf::SoundStream::Chunk &data) override;
+    virtual void onSeek(sf::Time timeOffset) override;
+
+   private:
+    sf::InputSoundFile file_;
+    std::vector<sf::Int16> samples_;
+    std::atomic<bool> is_loop_;
+    std::mutex mutex_;
+  };
+  struct Inner {
+    std::unique_ptr<Stream> stream_;
+    std::string filename_;
+    f32 volume_;
+    f32 gain_;
+    f32 fade_from_;
+    f32 fade_to_;
+    sf::Time fade_elapsed_;
+    sf::Time fade_duration_;
+    bool is_fading_;
+    bool stop_after_fade_;
+
+    explicit Inner();
+    explicit Inner(Inner const &rhs);
+    virtual Inner &operator=(Inner const &rhs);
+  } *ownership;
+
+ private:
+  explicit WrapMusic(WrapMusic::Inner *const &ownership) noexcept;
+  virtual void ownershipCheck() const;
+  virtual void applyVolume();
+
+}; // WrapMusic
+
+#endif // SFML_LIB_WRAPMUSIC_H_
@@ -1,14 +1,26 @@
 #ifndef SFML_LIB_WRAPSOUNDBUFFER_H_
 #define SFML_LIB_WRAPSOUNDBUFFER_H_
 
+#include <vector>
+
 #include <SFML/Audio/SoundBuffer.hpp>
 
+using u8 = unsigned char;
 using u32 = unsigned int;
+using usize = unsigned long;
+
+struct SoundBufferOptions {
+  bool is_mono = false;       // downmix every channel into one
+  u32 sample_rate = 0;        // 0: keep the source rate
+  bool is_compressed = false; // keep IMA ADPCM, decode on first use
+};
 
 class WrapSoundBuffer {
  public:
   explicit WrapSoundBuffer();
-  explicit WrapSoundBuffer(std::string const &filename);
+  explicit WrapSoundBuffer(std::string const &filename,
+                           SoundBufferOptions const &options =
+                               SoundBufferOptions());
   explicit WrapSoundBuffer(void const *data, std::size_t sizeInBytes);
   explicit WrapSoundBuffer(sf::InputStream &stream);
   explicit WrapSoundBuffer(sf::Int16 const *samples,
@@ -25,15 +37,31 @@ class WrapSoundBuffer {
   virtual sf::SoundBuffer &getSoundBuffer();
   virtual sf::SoundBuffer const &getSoundBuffer() const;
 
-  virtual void loadFromFile(std::string const &filename);
-  virtual void loadFromMemory(void const *data, std::size_t sizeInBytes);
-  virtual void loadFromStream(sf::InputStream &stream);
+  virtual void loadFromFile(std::string const &filename,
+                            SoundBufferOptions const &options =
+                                SoundBufferOptions());
+  virtual void loadFromMemory(void const *data,
+                              std::size_t sizeInBytes,
+                              SoundBufferOptions const &options =
+                                  SoundBufferOptions());
+  virtual void loadFromStream(sf::InputStream &stream,
+                              SoundBufferOptions const &options =
+                                  SoundBufferOptions());
   virtual void loadFromSamples(sf::Int16 const *samples,
                                sf::Uint64 sampleCount,
                                u32 channelCount,
-                               u32 sampleRate);
+                               u32 sampleRate,
+                               SoundBufferOptions const &options =
+                                   SoundBufferOptions());
   virtual void saveToFile(std::string const &filename) const;
 
+  virtual void compact(SoundBufferOptions const &options);
+  virtual bool isCompressed() const;
+  virtual bool isDecoded() const;
+  // drops the decoded cache of a compressed buffer, stop its sounds first
+  virtual void releaseDecoded() const;
+  virtual usize getMemoryUsage() const;
+
   virtual sf::Int16 const *getSamples() const;
   virtual sf::Uint64 getSampleCount() const;
   virtual u32 getSampleRate() const;
@@ -43,6 +71,12 @@ class WrapSoundBuffer {
  protected:
   struct Inner {
     sf::SoundBuffer sound_buffer_;
+    std::vector<u8> adpcm_;
+    sf::Uint64 sample_count_;
+    u32 sample_rate_;
+    u32 channel_count_;
+    bool is_compressed_;
+    bool is_decoded_;
 
     explicit Inner();
     explicit Inner(Inner const &rhs);
@@ -52,6 +86,8 @@ class WrapSoundBuffer {
  private:
   explicit WrapSoundBuffer(WrapSoundBuffer::Inner *const &ownership) noexcept;
   virtual void ownershipCheck() const;
+  virtual void decode() const;
+  virtual void applyOptions(SoundBufferOptions const &options);
 }; // WrapSoundBuffer
 
 #endif // SFML_LIB_WRAPSOUNDBUFFER_H_
@@ -1,5 +1,21 @@
 #include <common.h>
 
+u64 Program::tick_rate_       = u64(120);
+sf::Time Program::tick_       = sf::microseconds(1000000 / Program::tick_rate_);
+usize Program::max_catch_up_  = usize(5);
+u64 Program::tick_count_      = u64(0);
+bool Program::is_closing_     = false;
+bool Program::is_pipelined_   = false;
+sf::Time Program::upload_budget_ = sf::milliseconds(2);
+std::string Program::record_filename_;
+std::string Program::replay_filename_;
+
+std::mutex Program::mutex_;
+std::condition_variable Program::condition_;
+usize Program::published_     = usize(-1);
+bool Program::is_drawing_[Program::kSnapshotCount] = {};
+bool Program::is_rendering_   = false;
+
 void Program::run() {
   // auto fullModes = sf::VideoMode::getFullscreenModes();
   // if (fullModes.empty()) { /* error process */ }
@@ -16,42 +32,78 @@ void Program::run() {
 
   // fps manager
   FPSManager::setFramerateLimit(120);
+  FPSManager::setPacingMode(FPSManager::kHybrid);
+
+  // per tick passes split across cores, this thread is worker 0
+  JobManager::initialize();
+
+  // resources decode in the background, first frame shows up immediately
+  ResourceManager::initialize();
+  ResourceHandle fnt1 = ResourceManager::loadFont(
+      "resource/font/GoMonoNerdFont-Regular.ttf");
+  ResourceHandle tex1 = ResourceManager::loadTexture(
+      "resource/background/ereve.jpg");
+  ResourceHandle tex2 = ResourceManager::loadTexture(
+      "resource/maple/mob/green_mushroom/move/1110100.img.move.0.png",
+      [](WrapImage &image) {
+    image.createMaskFromColor(image.getPixel(0, 0)); // background to invisible
+  });
+  ResourceHandle tex3 = ResourceManager::loadTexture(
+      "resource/sprite/red_drake.png");
+  SoundBufferOptions sfx_options;
+  sfx_options.is_mono = true;
+  sfx_options.sample_rate = 22050;
+  sfx_options.is_compressed = true;
+  ResourceHandle sbf2 = ResourceManager::loadSoundBuffer(
+      "resource/sound/attack.mp3.flac", sfx_options);
+  ResourceHandle const resources[] = { fnt1, tex1, tex2, tex3, sbf2, };
+  usize const resource_count = sizeof(resources) / sizeof(ResourceHandle);
+  usize ready_count = 0;
 
   // fps counter
-  sf::Font fnt1;
-  if (!fnt1.loadFromFile("resource/font/GoMonoNerdFont-Regular.ttf")) {
-    throw std::runtime_error("fnt1 load failed!");
-  }
   sf::Text txt1;
-  txt1.setFont(fnt1);
   txt1.setStyle(sf::Text::Regular);
   txt1.setFillColor(sf::Color({ 255, 0, 0 }));
   txt1.setCharacterSize(16);
   txt1.setPosition(0, 0);
 
   // background
-  WrapImage img1("resource/background/ereve.jpg");
-  WrapTexture tex1(img1.getImage());
   sf::RectangleShape rts1;
   rts1.setSize(sf::Vector2f({ kWidth, kHeight }));
-  rts1.setTexture(&tex1.getTexture());
   rts1.setPosition(0, 0);
 
   // monster
-  WrapImage img2(
-      "resource/maple/mob/green_mushroom/move/1110100.img.move.0.png");
-  img2.createMaskFromColor(img2.getPixel(0, 0)); // background to invisible
-  WrapTexture tex2(img2.getImage());
-  sf::RectangleShape rts2;
-  rts2.setSize(sf::Vector2f({ 100, 100 }));
-  rts2.setTexture(&tex2.getTexture());
-  rts2.setPosition(300, 300);
+  Mob mob;
+  mob.setTextureRect(sf::IntRect({ 0, 0, 100, 100 }));
+  mob.setHitbox(sf::FloatRect({ 0, 0, 100, 100 }));
+  mob.setOrigin(50, 100); // feet, where physics puts the body
+  mob.setPosition(300, 300);
+  mob.setLayer(SpriteBatch::kMob);
+
+  // monster is pickable by the mouse through the broad phase
+  CollisionManager::initialize();
+  mob.initialize();
+  ColliderCodes picked;
+
+  // terrain, the monster walks, jumps and climbs on it
+  f32 const ground = kHeight - 20.0f;
+  PhysicsManager::initialize();
+  PhysicsManager::addFoothold(sf::Vector2f(0, 0), sf::Vector2f(0, ground));
+  PhysicsManager::addFoothold(sf::Vector2f(0, ground),
+                              sf::Vector2f(700, ground));
+  PhysicsManager::addFoothold(sf::Vector2f(700, ground),
+                              sf::Vector2f(1000, ground - 150));
+  PhysicsManager::addFoothold(sf::Vector2f(1000, ground - 150),
+                              sf::Vector2f(kWidth, ground - 150));
+  PhysicsManager::addFoothold(sf::Vector2f(kWidth, ground - 150),
+                              sf::Vector2f(kWidth, 0));
+  PhysicsManager::addFoothold(sf::Vector2f(200, 400), sf::Vector2f(500, 400));
+  PhysicsManager::addLadder(350, 400, ground);
+  usize mob_body = PhysicsManager::createBody(mob.getHandle(),
+                                              sf::Vector2f(100, 100));
 
   // sprite
-  WrapImage img3("resource/sprite/red_drake.png");
-  WrapTexture tex3(img3.getImage());
   sf::Sprite spr1;
-  spr1.setTexture(tex3.getTexture());
   spr1.setTextureRect(sf::IntRect({ 0, 0, 130, 100 }));
   spr1.setPosition(200, 200);
   spr1.setOrigin(spr1.getTextureRect().width / 2,
@@ -69,38 +121,95 @@ void Program::run() {
   // AnimeStore const &asd = anm1.getAnimes();
   // std::cout << asd[0][0].first.width << '\n';
 
-  WrapSoundBuffer sbf1("resource/sound/ereve.mp3");
-  WrapSoundBuffer sbf2("resource/sound/attack.mp3.flac");
-  sf::Sound snd1(sbf1.getSoundBuffer());
-  sf::Sound snd2(sbf2.getSoundBuffer());
-  // background music
-  snd1.setVolume(100);
-  snd1.setLoop(true);
-  snd1.play();
-  // attack sound
-  snd2.setVolume(100);
-  snd2.setLoop(false);
+  // background music, streamed and crossfaded between two decks
+  std::string const bgm_filenames[] = {
+    "resource/sound/ereve.mp3",
+    "resource/sound/henesys_FloralLife.mp3",
+    "resource/sound/orbis_ShininHarbor.mp3",
+    "resource/sound/leafre.mp3",
+  };
+  usize const bgm_count = sizeof(bgm_filenames) / sizeof(std::string);
+  usize bgm_code = 0;
+  WrapMusic bgms[2];
+  usize deck = 0;
+  for (WrapMusic &bgm : bgms) { bgm.setLoop(true); }
+  bgms[deck].openFromFile(bgm_filenames[bgm_code]);
+  bgms[deck].play();
+
+  // attack sound, voices come from the shared pool
+  SoundManager::initialize();
+  usize snd2_code = usize(-1);
+  auto play_attack = [&]() {
+    if (snd2_code != usize(-1)) { SoundManager::play(snd2_code); }
+  };
+
+  // bind each resource once it becomes ready
+  auto bind = [&]() {
+    if (ready_count == resource_count) { return; }
+    ready_count = 0;
+    for (ResourceHandle const &resource : resources) {
+      if (resource.getState() == ResourceManager::kFailed) {
+        throw std::runtime_error(resource.getError());
+      }
+      ready_count += resource.isReady();
+    }
+    if (txt1.getFont() == nullptr && fnt1.isReady()) {
+      txt1.setFont(fnt1.getFont());
+    }
+    if (rts1.getTexture() == nullptr && tex1.isReady()) {
+      rts1.setTexture(&tex1.getTexture().getTexture());
+    }
+    if (mob.getTexture() == nullptr && tex2.isReady()) {
+      sf::Texture const &texture = tex2.getTexture().getTexture();
+      sf::Vector2f size(texture.getSize());
+      // the whole texture squeezed into the 100 x 100 body
+      mob.setTexture(&texture);
+      mob.setTextureRect(sf::IntRect({ 0, 0, i32(size.x), i32(size.y) }));
+      mob.setHitbox(sf::FloatRect({ 0, 0, size.x, size.y }));
+      mob.setOrigin(size.x / 2, size.y);
+      mob.setScale(100 / size.x, 100 / size.y);
+    }
+    if (spr1.getTexture() == nullptr && tex3.isReady()) {
+      spr1.setTexture(tex3.getTexture().getTexture());
+    }
+    if (snd2_code == usize(-1) && sbf2.isReady()) {
+      snd2_code = SoundManager::registerSound(sbf2.getSoundBuffer(), 8);
+    }
+  };
 
   // KeyMap
   KeyManager::KeyMap kmap(sf::Keyboard::KeyCount);
   KeyManager::setKeyMap(&kmap);
   kmap.setKeyCallback(sf::Keyboard::Escape, KeyManager::kPress, [&]() {
-    window.close();
+    Program::close();
   });
   kmap.setKeyCallback(sf::Keyboard::Hyphen, KeyManager::kPress, [&]() {
-    snd1.setVolume(fmax(snd1.getVolume() - 3, 0));
+    for (WrapMusic &bgm : bgms) { bgm.setVolume(bgm.getVolume() - 3); }
   }, true);
   kmap.setKeyCallback(sf::Keyboard::Equal, KeyManager::kPress, [&]() {
-    snd1.setVolume(fmin(snd1.getVolume() + 3, 100));
+    for (WrapMusic &bgm : bgms) { bgm.setVolume(bgm.getVolume() + 3); }
   }, true);
   kmap.setKeyCallback(sf::Keyboard::LBracket, KeyManager::kPress, [&]() {
-    snd1.setPlayingOffset(snd1.getPlayingOffset() - sf::seconds(2));
+    bgms[deck].setPlayingOffset(bgms[deck].getPlayingOffset() -
+                                sf::seconds(2));
   }, true);
   kmap.setKeyCallback(sf::Keyboard::RBracket, KeyManager::kPress, [&]() {
-    snd1.setPlayingOffset(snd1.getPlayingOffset() + sf::seconds(2));
+    bgms[deck].setPlayingOffset(bgms[deck].getPlayingOffset() +
+                                sf::seconds(2));
   }, true);
+  kmap.setKeyCallback(sf::Keyboard::Tab, KeyManager::kPress, [&]() {
+    bgm_code = (bgm_code + 1) % bgm_count;
+    usize next = (deck + 1) % 2;
+    bgms[next].stop();
+    bgms[next].openFromFile(bgm_filenames[bgm_code]);
+    bgms[deck].crossfade(bgms[next], sf::seconds(2));
+    deck = next;
+  });
+  kmap.setKeyCallback(sf::Keyboard::LAlt, KeyManager::kPress, [&]() {
+    PhysicsManager::jump(mob_body, 700.0f);
+  });
   kmap.setKeyCallback(sf::Keyboard::Space, KeyManager::kPress, [&]() {
-    snd2.play();
+    play_attack();
   });
 
   // MouseMap
@@ -108,50 +217,319 @@ void Program::run() {
   MouseManager::setButtonMap(&bmap);
   MouseManager::setMouseEventCallback(
       MouseManager::kVerScrollUp, [&](int x, int y) {
-    snd2.play();
+    play_attack();
   });
   MouseManager::setMouseEventCallback(
       MouseManager::kVerScrollDown, [&](int x, int y) {
-    snd2.play();
+    play_attack();
   });
   bmap.setButtonCallback(
       sf::Mouse::Left, MouseManager::kPress, [&](int x, int y) {
-    snd2.play();
+    if (snd2_code != usize(-1)) { // heard from where the click landed
+      SoundManager::playAt(snd2_code, sf::Vector2f(x, y));
+    }
+  });
+  bmap.setButtonCallback(
+      sf::Mouse::Right, MouseManager::kPress, [&](int x, int y) {
+    CollisionManager::queryPoint(sf::Vector2f(x, y), picked);
+    for (usize const &collider_code : picked) {
+      if (collider_code == mob.getColliderCode() &&
+          snd2_code != usize(-1)) {
+        mob.emit(snd2_code);
+      }
+    }
   });
 
-  sf::Event event;
-  while (window.isOpen()) {
-    // update
-    while (window.pollEvent(event)) {
-      if (event.type == sf::Event::Closed) {
-        window.close();
-      } else if (event.type >= sf::Event::KeyPressed &&
-                 event.type <= sf::Event::KeyReleased) {
-        KeyManager::eventProcess(event);
-      } else if (event.type >= sf::Event::MouseWheelScrolled &&
-                 event.type <= sf::Event::MouseLeft) {
-        MouseManager::eventProcess(event);
+  // simulation
+  f32 rotation_prev = spr1.getRotation();
+  f32 rotation_curr = rotation_prev;
+  UpdateCallback update = [&](sf::Time const &dt) {
+    bind();
+    for (WrapMusic &bgm : bgms) { bgm.update(dt); }
+    SoundManager::setListenerPosition(spr1.getPosition());
+    f32 walk = 0.0f;
+    f32 climb = 0.0f;
+    walk -= KeyManager::getKeyState(sf::Keyboard::Left) ? 200.0f : 0.0f;
+    walk += KeyManager::getKeyState(sf::Keyboard::Right) ? 200.0f : 0.0f;
+    climb -= KeyManager::getKeyState(sf::Keyboard::Up) ? 150.0f : 0.0f;
+    climb += KeyManager::getKeyState(sf::Keyboard::Down) ? 150.0f : 0.0f;
+    if (climb != 0.0f &&
+        PhysicsManager::getState(mob_body) != PhysicsManager::kLadder) {
+      PhysicsManager::grabLadder(mob_body);
+    }
+    PhysicsManager::walk(mob_body, walk);
+    PhysicsManager::climb(mob_body, climb);
+    AnimationManager::advance(dt);
+    PhysicsManager::step(dt);
+    mob.update();
+    rotation_prev = rotation_curr;
+    rotation_curr += 1.0f;
+    if (rotation_curr >= 360.0f) {
+      rotation_prev -= 360.0f;
+      rotation_curr -= 360.0f;
+    }
+  };
+
+  // render, world sprites go through one batch per snapshot
+  SpriteBatch batch_snapshots[Program::kSnapshotCount];
+  sf::Text txt1_snapshots[Program::kSnapshotCount];
+  bool loaded_snapshots[Program::kSnapshotCount] = {};
+  SnapshotCallback snapshot = [&](usize const &snapshot_code,
+                                  f32 const &alpha) {
+    loaded_snapshots[snapshot_code] = ready_count == resource_count;
+    if (!loaded_snapshots[snapshot_code]) {
+      txt1.setString("loading " + std::to_string(ready_count) + " / " +
+                     std::to_string(resource_count));
+      txt1_snapshots[snapshot_code] = txt1;
+      return;
+    }
+    FPSManager::FrameStats const &stats = FPSManager::getFrameStats();
+    txt1.setString(std::to_string(FPSManager::getCurrentFPS()) +
+                   " fps / p50 " + std::to_string(stats.p50) +
+                   "us / p99 " + std::to_string(stats.p99) +
+                   "us / max " + std::to_string(stats.max) +
+                   "us / err " + std::to_string(FPSManager::getPacingError()) +
+                   "us / input " + std::to_string(
+                       InputManager::getLatency().asMicroseconds()) + "us");
+    spr1.setRotation(rotation_prev + (rotation_curr - rotation_prev) * alpha);
+    SpriteBatch &batch = batch_snapshots[snapshot_code];
+    batch.clear();
+    batch.draw(rts1, SpriteBatch::kBackground, 0.0f);
+    mob.submit(batch);
+    batch.draw(spr1, SpriteBatch::kPlayer, 0.0f);
+    txt1_snapshots[snapshot_code] = txt1;
+  };
+  DrawCallback draw = [&](sf::RenderTarget &target,
+                          usize const &snapshot_code) {
+    if (!loaded_snapshots[snapshot_code]) {
+      target.clear();
+      if (txt1_snapshots[snapshot_code].getFont() != nullptr) {
+        target.draw(txt1_snapshots[snapshot_code]);
       }
+      return;
     }
-    KeyManager::framework();
-    MouseManager::framework(window);
-    txt1.setString(std::to_string(FPSManager::getCurrentFPS()));
-    
+    SpriteBatch &batch = batch_snapshots[snapshot_code];
+    batch.render(target);
+    sf::Text &text = txt1_snapshots[snapshot_code]; // calls of this render
+    text.setString(text.getString() + " / draw " +
+                   std::to_string(batch.getDrawCallCount()));
+    target.draw(text);
+  };
+
+  Program::setTickRate(120);
+  if (!Program::replay_filename_.empty()) {
+    InputRecorder::loadFromFile(Program::replay_filename_);
+    Program::setTickRate(InputRecorder::getTickRate());
+    InputRecorder::replay();
+    FPSManager::setFramerateLimit(0);
+    window.setVisible(false);
+  } else if (!Program::record_filename_.empty()) {
+    InputRecorder::record(Program::tick_rate_);
+  }
+  Program::loop(window, update, snapshot, draw);
+  if (InputRecorder::isRecording()) {
+    InputRecorder::setTickCount(Program::tick_count_);
+    InputRecorder::saveToFile(Program::record_filename_);
+  }
+  InputRecorder::stop();
+  AnimationManager::release();
+  PhysicsManager::release();
+  CollisionManager::release();
+  SoundManager::release();
+  ResourceManager::release();
+  JobManager::release();
+}
+
+void Program::close() noexcept {
+  Program::is_closing_ = true;
+}
+
+u64 const &Program::getTickRate() noexcept {
+  return Program::tick_rate_;
+}
 
-    spr1.setRotation(usize(spr1.getRotation() + 1.0f) % 360);
+void Program::setTickRate(u64 const &tick_rate) {
+  if (tick_rate == 0) {
+    throw std::runtime_error("tick_rate must be greater than 0.");
+  }
+  Program::tick_rate_ = tick_rate;
+  Program::tick_ = sf::microseconds(1000000 / tick_rate);
+}
+
+usize const &Program::getMaxCatchUp() noexcept {
+  return Program::max_catch_up_;
+}
+
+void Program::setMaxCatchUp(usize const &max_catch_up) {
+  if (max_catch_up == 0) {
+    throw std::runtime_error("max_catch_up must be greater than 0.");
+  }
+  Program::max_catch_up_ = max_catch_up;
+}
+
+bool const &Program::isPipelined() noexcept {
+  return Program::is_pipelined_;
+}
+
+void Program::setPipelined(bool const &is_pipelined) noexcept {
+  Program::is_pipelined_ = is_pipelined;
+}
+
+sf::Time const &Program::getUploadBudget() noexcept {
+  return Program::upload_budget_;
+}
+
+void Program::setUploadBudget(sf::Time const &upload_budget) noexcept {
+  Program::upload_budget_ = upload_budget;
+}
+
+u64 const &Program::getTickCount() noexcept {
+  return Program::tick_count_;
+}
+
+std::string const &Program::getRecordFilename() noexcept {
+  return Program::record_filename_;
+}
+
+void Program::setRecordFilename(std::string const &filename) {
+  Program::record_filename_ = filename;
+}
+
+std::string const &Program::getReplayFilename() noexcept {
+  return Program::replay_filename_;
+}
+
+void Program::setReplayFilename(std::string const &filename) {
+  Program::replay_filename_ = filename;
+}
+
+void Program::loop(sf::RenderWindow &window,
+                   UpdateCallback const &update,
+                   SnapshotCallback const &snapshot,
+                   DrawCallback const &draw) {
+  std::thread render_thread;
+  if (Program::is_pipelined_) {
+    window.setActive(false);
+    Program::is_rendering_ = true;
+    render_thread = std::thread(Program::renderLoop, std::ref(window), draw);
+  }
+  InputManager::initialize();
+  bool const is_replaying = InputRecorder::isReplaying();
+  // the cursor from events only, the real one is not part of a recording
+  bool const is_deterministic = InputRecorder::isRecording() || is_replaying;
+  sf::Clock clock;
+  sf::Time accumulator;
+  usize snapshot_code = 0;
+  Program::is_closing_ = false;
+  while (window.isOpen() && !Program::is_closing_) {
+    Program::eventProcess(window);
+
+    // update, each tick takes the input captured before its end, a replay
+    // runs max_catch_up_ ticks every frame without looking at the clock
+    if (!is_replaying) { accumulator += clock.restart(); }
+    sf::Time now = InputManager::getTime();
+    usize steps = 0;
+    while ((is_replaying ? !InputRecorder::isFinished() :
+                           accumulator >= Program::tick_) &&
+           steps < Program::max_catch_up_) {
+      if (is_replaying) {
+        InputRecorder::feed(Program::tick_count_);
+      } else {
+        accumulator -= Program::tick_;
+        InputManager::dispatch(now - accumulator, Program::tick_count_);
+      }
+      KeyManager::framework();
+      if (is_deterministic) {
+        MouseManager::framework(MouseManager::getPosition());
+      } else {
+        MouseManager::framework(window);
+      }
+      update(Program::tick_);
+      ++Program::tick_count_;
+      ++steps;
+    }
+    if (accumulator >= Program::tick_) { // drop backlog, no spiral of death
+      accumulator = accumulator % Program::tick_;
+    }
+    if (is_replaying && InputRecorder::isFinished()) { Program::close(); }
 
     // render
-    window.draw(rts1);
-    window.draw(rts2);
-    window.draw(spr1);
-    window.draw(txt1);
-    window.display();
+    if (Program::is_pipelined_) {
+      std::unique_lock<std::mutex> lock(Program::mutex_);
+      Program::condition_.wait(lock, [&]() {
+        return !Program::is_drawing_[snapshot_code];
+      });
+      lock.unlock();
+      snapshot(snapshot_code, accumulator / Program::tick_);
+      lock.lock();
+      Program::condition_.wait(lock, []() {
+        return Program::published_ == usize(-1);
+      });
+      Program::published_ = snapshot_code;
+      Program::is_drawing_[snapshot_code] = true;
+      lock.unlock();
+      Program::condition_.notify_all();
+      snapshot_code = (snapshot_code + 1) % Program::kSnapshotCount;
+    } else {
+      snapshot(snapshot_code, accumulator / Program::tick_);
+      ResourceManager::uploadPending(Program::upload_budget_);
+      draw(window, snapshot_code);
+      window.display();
+    }
 
     // fps managing
+    SoundManager::framework();
     FPSManager::framePulse();
   }
+  if (render_thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(Program::mutex_);
+      Program::is_rendering_ = false;
+    }
+    Program::condition_.notify_all();
+    render_thread.join();
+    window.setActive(true);
+  }
+  window.close();
 }
 
-void Program::loop() {
+void Program::renderLoop(sf::RenderWindow &window, DrawCallback const &draw) {
+  window.setActive(true);
+  while (true) {
+    std::unique_lock<std::mutex> lock(Program::mutex_);
+    Program::condition_.wait(lock, []() {
+      return Program::published_ != usize(-1) || !Program::is_rendering_;
+    });
+    if (Program::published_ == usize(-1)) { break; }
+    usize snapshot_code = Program::published_;
+    Program::published_ = usize(-1);
+    lock.unlock();
+    Program::condition_.notify_all();
+
+    ResourceManager::uploadPending(Program::upload_budget_);
+    draw(window, snapshot_code);
+    window.display();
+
+    lock.lock();
+    Program::is_drawing_[snapshot_code] = false;
+    lock.unlock();
+    Program::condition_.notify_all();
+  }
+  window.setActive(false);
+}
 
+void Program::eventProcess(sf::RenderWindow &window) {
+  sf::Event event;
+  while (window.pollEvent(event)) {
+    if (event.type == sf::Event::Closed) {
+      Program::close();
+    } else if (InputRecorder::isReplaying()) {
+      continue; // only the recording drives a replay
+    } else if ((event.type >= sf::Event::KeyPressed &&
+                event.type <= sf::Event::KeyReleased) ||
+               (event.type >= sf::Event::MouseWheelScrolled &&
+                event.type <= sf::Event::MouseLeft)) {
+      InputManager::push(event);
+    }
+  }
 }
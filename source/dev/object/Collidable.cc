@@ -1,17 +1,64 @@
 #include <dev/object/Collidable.h>
 
+Collidable::~Collidable() noexcept {
+}
+
+sf::FloatRect const &Collidable::getHitbox() const {
+  return collidable_ownership->hitbox_;
+}
+
+void Collidable::setHitbox(sf::FloatRect const &hitbox) {
+  collidable_ownership->hitbox_ = hitbox;
+}
+
+sf::FloatRect Collidable::getGlobalBounds() const {
+  return ObjectManager::getTransform(this->getHandle())
+      .transformRect(this->getHitbox());
+}
+
+usize const &Collidable::getColliderCode() const {
+  return collidable_ownership->collider_code_;
+}
+
+void Collidable::updateCollider() {
+  Collidable::Inner &inner = *collidable_ownership;
+  if (!CollisionManager::isAlive(inner.collider_code_)) {
+    inner.collider_code_ = CollisionManager::insert(inner.handle_,
+                                                    this->getGlobalBounds());
+    return;
+  }
+  CollisionManager::update(inner.collider_code_, this->getGlobalBounds());
+}
+
 Collidable::Inner::Inner()
-    : Object::Inner() {
+    : Object::Inner(),
+      hitbox_(),
+      collider_code_(usize(-1)) {
 }
 
-Collidable::Inner::Inner(Collidable::Inner const &rhs) {
+Collidable::Inner::Inner(Collidable::Inner const &rhs)
+    : collider_code_(usize(-1)) {
   *this = rhs;
 }
 
+// the copy registers its own collider on its first update
 Collidable::Inner &Collidable::Inner::operator=(Collidable::Inner const &rhs) {
   if (this == &rhs) { return *this; }
-  dynamic_cast<Object::Inner &>(*this) =
-      dynamic_cast<Object::Inner const &>(rhs);
+  static_cast<Object::Inner &>(*this) =
+      static_cast<Object::Inner const &>(rhs);
+  this->hitbox_ = rhs.hitbox_;
 
   return *this;
 }
+
+Collidable::Inner::~Inner() {
+  if (CollisionManager::isAlive(collider_code_)) {
+    CollisionManager::remove(collider_code_);
+  }
+}
+
+// ignored for the virtual Object unless Collidable is the most derived
+Collidable::Collidable(Collidable::Inner *const &ownership) noexcept
+    : Object(ownership),
+      collidable_ownership(ownership) {
+}
@@ -1,7 +1,34 @@
 #include <dev/object/Hearable.h>
 
+Hearable::~Hearable() noexcept {
+}
+
+f32 const &Hearable::getAudibleRange() const {
+  return hearable_ownership->audible_range_;
+}
+
+void Hearable::setAudibleRange(f32 const &audible_range) {
+  hearable_ownership->audible_range_ = audible_range;
+}
+
+bool Hearable::isAudible() const {
+  return SoundManager::getAttenuation(this->getPosition(),
+                                      this->getAudibleRange()) > 0.0f;
+}
+
+usize Hearable::emit(usize const &sound_code,
+                     f32 const &volume,
+                     f32 const &pitch) const {
+  return SoundManager::playAt(sound_code,
+                              this->getPosition(),
+                              this->getAudibleRange(),
+                              volume,
+                              pitch);
+}
+
 Hearable::Inner::Inner()
-    : Object::Inner() {
+    : Object::Inner(),
+      audible_range_(SoundManager::kDefaultAudibleRange) {
 }
 
 Hearable::Inner::Inner(Hearable::Inner const &rhs) {
@@ -10,8 +37,14 @@ Hearable::Inner::Inner(Hearable::Inner const &rhs) {
 
 Hearable::Inner &Hearable::Inner::operator=(Hearable::Inner const &rhs) {
   if (this == &rhs) { return *this; }
-  dynamic_cast<Object::Inner &>(*this) =
-      dynamic_cast<Object::Inner const &>(rhs);
-
+  static_cast<Object::Inner &>(*this) =
+      static_cast<Object::Inner const &>(rhs);
+  this->audible_range_ = rhs.audible_range_;
   return *this;
 }
+
+// ignored for the virtual Object unless Hearable is the most derived
+Hearable::Hearable(Hearable::Inner *const &ownership) noexcept
+    : Object(ownership),
+      hearable_ownership(ownership) {
+}
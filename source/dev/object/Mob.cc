@@ -0,0 +1,64 @@
+#include <dev/object/Mob.h>
+
+#include <stdexcept>
+
+Mob::Mob()
+    : Mob(new Mob::Inner()) {
+}
+
+Mob::~Mob() noexcept {
+}
+
+void Mob::initialize() {
+  this->ownershipCheck();
+  this->updateCollider();
+}
+
+void Mob::update() {
+  this->ownershipCheck();
+  this->updateCollider();
+}
+
+// drawn through submit, the batch owns the draw calls
+void Mob::render() {
+}
+
+// the handle and the collider go with the Inner
+void Mob::release() {
+}
+
+Mob::Inner::Inner()
+    : Object::Inner(),
+      Visible::Inner(),
+      Collidable::Inner(),
+      Hearable::Inner() {
+}
+
+Mob::Inner::Inner(Mob::Inner const &rhs) {
+  *this = rhs;
+}
+
+Mob::Inner &Mob::Inner::operator=(Mob::Inner const &rhs) {
+  if (this == &rhs) { return *this; }
+  static_cast<Visible::Inner &>(*this) =
+      static_cast<Visible::Inner const &>(rhs);
+  static_cast<Collidable::Inner &>(*this) =
+      static_cast<Collidable::Inner const &>(rhs);
+  static_cast<Hearable::Inner &>(*this) =
+      static_cast<Hearable::Inner const &>(rhs);
+
+  return *this;
+}
+
+Mob::Mob(Mob::Inner *const &ownership) noexcept
+    : Object(ownership),
+      Visible(ownership),
+      Collidable(ownership),
+      Hearable(ownership) {
+}
+
+void Mob::ownershipCheck() const {
+  if (ownership == nullptr) {
+    throw std::runtime_error("No ownership rights whatsoever: Mob");
+  }
+}
@@ -1,75 +1,89 @@
 #include <dev/object/Object.h>
 
+Object::~Object() noexcept {
+  if (ownership != nullptr) { delete ownership; }
+}
+
 sf::Vector2f const &Object::getPosition() const {
-  return ownership->position_;
+  return ObjectManager::getPosition(ownership->handle_);
 }
 
 f32 const &Object::getZDepth() const {
-  return ownership->z_depth_;
+  return ObjectManager::getZDepth(ownership->handle_);
 }
 
 f32 const &Object::getRotation() const {
-  return ownership->rotation_;
+  return ObjectManager::getRotation(ownership->handle_);
 }
 
 sf::Vector2f const &Object::getScale() const {
-  return ownership->scale_;
+  return ObjectManager::getScale(ownership->handle_);
 }
 
 sf::Vector2f const &Object::getOrigin() const {
-  return ownership->origin_;
+  return ObjectManager::getOrigin(ownership->handle_);
+}
+
+ObjectManager::Handle const &Object::getHandle() const {
+  return ownership->handle_;
 }
 
 void Object::setPosition(f32 x, f32 y) {
-  ownership->position_ = sf::Vector2f(x, y);
+  ObjectManager::setPosition(ownership->handle_, sf::Vector2f(x, y));
 }
 
 void Object::setPosition(sf::Vector2f const &position) {
-  ownership->position_ = position;
+  ObjectManager::setPosition(ownership->handle_, position);
 }
 
 void Object::setZDepth(f32 const &z_depth) {
-  ownership->z_depth_ = z_depth;
+  ObjectManager::setZDepth(ownership->handle_, z_depth);
 }
 
 void Object::setRotation(f32 const &angle) {
-  ownership->rotation_ = angle;
+  ObjectManager::setRotation(ownership->handle_, angle);
 }
 
 void Object::setScale(f32 factor_x, f32 factor_y) {
-  ownership->scale_ = sf::Vector2f(factor_x, factor_y);
+  ObjectManager::setScale(ownership->handle_,
+                          sf::Vector2f(factor_x, factor_y));
 }
 
 void Object::setScale(sf::Vector2f const &factor) {
-  ownership->scale_ = factor;
+  ObjectManager::setScale(ownership->handle_, factor);
 }
 
 void Object::setOrigin(f32 x, f32 y) {
-  ownership->origin_ = sf::Vector2f(x, y);
+  ObjectManager::setOrigin(ownership->handle_, sf::Vector2f(x, y));
 }
 
 void Object::setOrigin(sf::Vector2f const &origin) {
-  ownership->origin_ = origin;
+  ObjectManager::setOrigin(ownership->handle_, origin);
 }
 
 Object::Inner::Inner()
-    : position_(),
-      z_depth_(),
-      rotation_(),
-      scale_(),
-      origin_() {
+    : handle_(ObjectManager::create()) {
 }
 
-Object::Inner::Inner(Object::Inner const &rhs) {
+Object::Inner::Inner(Object::Inner const &rhs)
+    : handle_(ObjectManager::create()) {
   *this = rhs;
 }
 
 Object::Inner &Object::Inner::operator=(Object::Inner const &rhs) {
   if (this == &rhs) { return *this; }
-  this->position_ = rhs.position_;
-  this->z_depth_ = rhs.z_depth_;
-  this->rotation_ = rhs.rotation_;
-  this->scale_ = rhs.scale_;
-  this->origin_ = rhs.origin_;
+  ObjectManager::setPosition(handle_, ObjectManager::getPosition(rhs.handle_));
+  ObjectManager::setZDepth(handle_, ObjectManager::getZDepth(rhs.handle_));
+  ObjectManager::setRotation(handle_, ObjectManager::getRotation(rhs.handle_));
+  ObjectManager::setScale(handle_, ObjectManager::getScale(rhs.handle_));
+  ObjectManager::setOrigin(handle_, ObjectManager::getOrigin(rhs.handle_));
   return *this;
 }
+
+Object::Inner::~Inner() {
+  if (ObjectManager::isAlive(handle_)) { ObjectManager::destroy(handle_); }
+}
+
+Object::Object(Object::Inner *const &ownership) noexcept
+    : ownership(ownership) {
+}
@@ -1,7 +1,55 @@
 #include <dev/object/Visible.h>
 
+Visible::~Visible() noexcept {
+}
+
+sf::Texture const *Visible::getTexture() const {
+  return visible_ownership->texture_;
+}
+
+sf::IntRect const &Visible::getTextureRect() const {
+  return visible_ownership->texture_rect_;
+}
+
+sf::Color const &Visible::getColor() const {
+  return visible_ownership->color_;
+}
+
+SpriteBatch::Layer const &Visible::getLayer() const {
+  return visible_ownership->layer_;
+}
+
+void Visible::setTexture(sf::Texture const *const &texture) {
+  visible_ownership->texture_ = texture;
+}
+
+void Visible::setTextureRect(sf::IntRect const &texture_rect) {
+  visible_ownership->texture_rect_ = texture_rect;
+}
+
+void Visible::setColor(sf::Color const &color) {
+  visible_ownership->color_ = color;
+}
+
+void Visible::setLayer(SpriteBatch::Layer const &layer) {
+  visible_ownership->layer_ = layer;
+}
+
+void Visible::submit(SpriteBatch &sprite_batch) const {
+  Visible::Inner const &inner = *visible_ownership;
+  sprite_batch.draw(inner.texture_, inner.texture_rect_,
+                    sf::Vector2f(inner.texture_rect_.width,
+                                 inner.texture_rect_.height),
+                    ObjectManager::getTransform(inner.handle_), inner.layer_,
+                    ObjectManager::getZDepth(inner.handle_), inner.color_);
+}
+
 Visible::Inner::Inner()
-    : Object::Inner() {
+    : Object::Inner(),
+      texture_(),
+      texture_rect_(),
+      color_(sf::Color::White),
+      layer_(SpriteBatch::kBackground) {
 }
 
 Visible::Inner::Inner(Visible::Inner const &rhs) {
@@ -10,8 +58,18 @@ Visible::Inner::Inner(Visible::Inner const &rhs) {
 
 Visible::Inner &Visible::Inner::operator=(Visible::Inner const &rhs) {
   if (this == &rhs) { return *this; }
-  dynamic_cast<Object::Inner &>(*this) =
-      dynamic_cast<Object::Inner const &>(rhs);
+  static_cast<Object::Inner &>(*this) =
+      static_cast<Object::Inner const &>(rhs);
+  this->texture_ = rhs.texture_;
+  this->texture_rect_ = rhs.texture_rect_;
+  this->color_ = rhs.color_;
+  this->layer_ = rhs.layer_;
 
   return *this;
 }
+
+// ignored for the virtual Object unless Visible is the most derived
+Visible::Visible(Visible::Inner *const &ownership) noexcept
+    : Object(ownership),
+      visible_ownership(ownership) {
+}
@@ -1,17 +1,20 @@
 #include <lib/Animation.h>
 
+#include <algorithm>
+#include <cstdlib>
+
 Animation::Animation()
     : ownership(new Animation::Inner()) {
 }
 
 Animation::Animation(AnimeStore const &animes)
     : ownership(new Animation::Inner()) {
-  ownership->animes_.assign(animes.begin(), animes.end());
+  this->setAnimes(animes);
 }
 
 Animation::Animation(usize const &anime_count)
     : ownership(new Animation::Inner()) {
-  ownership->animes_.resize(anime_count);
+  this->setAnimeCount(anime_count);
 }
 
 Animation::Animation(Animation const &rhs)
@@ -38,59 +41,158 @@ Animation Animation::clone() const {
 
 usize Animation::getAnimeCount() const {
   this->ownershipCheck();
-  return ownership->animes_.size();
+  return ownership->offsets_.size() - 1;
 }
 
 void Animation::setAnimeCount(usize const &anime_count) {
   this->ownershipCheck();
-  ownership->animes_.resize(anime_count);
+  std::vector<usize> &offsets = ownership->offsets_;
+  if (anime_count < offsets.size() - 1) {
+    offsets.resize(anime_count + 1);
+    ownership->motions_.resize(offsets.back());
+    ownership->ends_.resize(offsets.back());
+    if (ownership->is_baked_) { ownership->quads_.resize(offsets.back()); }
+  } else {
+    offsets.resize(anime_count + 1, offsets.back());
+  }
+  ownership->frame_times_.resize(anime_count);
 }
 
 usize Animation::getMotionCount(usize const &anime_code) const {
   this->codeCheck(anime_code);
-  return ownership->animes_[anime_code].size();
+  return ownership->offsets_[anime_code + 1] -
+         ownership->offsets_[anime_code];
 }
 
 void Animation::setMotionCount(usize const &anime_code,
                                usize const &motion_count) {
   this->codeCheck(anime_code);
-  ownership->animes_[anime_code].resize(motion_count);
+  this->resizeAnime(anime_code, motion_count);
+  this->rebuild(anime_code);
 }
 
-AnimeStore const &Animation::getAnimes() const {
+AnimeStore Animation::getAnimes() const {
   this->ownershipCheck();
-  return ownership->animes_;
+  AnimeStore animes(this->getAnimeCount());
+  for (usize i = 0; i < animes.size(); ++i) {
+    animes[i] = this->getAnime(i);
+  }
+  return animes;
 }
 
 void Animation::setAnimes(AnimeStore const &animes) {
   this->ownershipCheck();
-  ownership->animes_.assign(animes.begin(), animes.end());
+  Animation::Inner &inner = *ownership;
+  inner.motions_.clear();
+  inner.offsets_.assign(1, 0);
+  for (Anime const &anime : animes) {
+    inner.motions_.insert(inner.motions_.end(), anime.begin(), anime.end());
+    inner.offsets_.push_back(inner.motions_.size());
+  }
+  inner.ends_.resize(inner.motions_.size());
+  inner.frame_times_.resize(animes.size());
+  if (inner.is_baked_) { inner.quads_.resize(inner.motions_.size()); }
+  for (usize i = 0; i < animes.size(); ++i) { this->rebuild(i); }
 }
 
-Anime const &Animation::getAnime(usize const &anime_code) const {
+Anime Animation::getAnime(usize const &anime_code) const {
   this->codeCheck(anime_code);
-  return ownership->animes_[anime_code];
+  return Anime(
+      ownership->motions_.begin() + ownership->offsets_[anime_code],
+      ownership->motions_.begin() + ownership->offsets_[anime_code + 1]);
 }
 
 void Animation::setAnime(usize const &anime_code, Anime const &anime) {
   this->codeCheck(anime_code);
-  ownership->animes_[anime_code].assign(anime.begin(), anime.end());
+  this->resizeAnime(anime_code, anime.size());
+  std::copy(anime.begin(), anime.end(),
+            ownership->motions_.begin() + ownership->offsets_[anime_code]);
+  this->rebuild(anime_code);
+}
+
+Motion const *Animation::getMotions(usize const &anime_code) const {
+  this->codeCheck(anime_code);
+  return ownership->motions_.data() + ownership->offsets_[anime_code];
+}
+
+sf::Time const &Animation::getDuration(usize const &anime_code) const {
+  this->codeCheck(anime_code);
+  usize const &end = ownership->offsets_[anime_code + 1];
+  if (end == ownership->offsets_[anime_code]) { return sf::Time::Zero; }
+  return ownership->ends_[end - 1];
+}
+
+sf::Time const &Animation::getFrameTime(usize const &anime_code) const {
+  this->codeCheck(anime_code);
+  return ownership->frame_times_[anime_code];
+}
+
+usize Animation::getMotionCode(usize const &anime_code,
+                               sf::Time const &elapsed) const {
+  this->codeCheck(anime_code);
+  usize const &begin = ownership->offsets_[anime_code];
+  usize const &end = ownership->offsets_[anime_code + 1];
+  if (begin == end || elapsed <= sf::Time::Zero) { return 0; }
+  usize const last = end - begin - 1;
+  sf::Time const &frame_time = ownership->frame_times_[anime_code];
+  if (frame_time > sf::Time::Zero) {
+    return std::min(usize(elapsed.asMicroseconds() /
+                          frame_time.asMicroseconds()), last);
+  }
+  std::vector<sf::Time>::const_iterator ends = ownership->ends_.begin();
+  usize motion_code = std::upper_bound(ends + begin, ends + end, elapsed) -
+                      (ends + begin);
+  return std::min(motion_code, last);
+}
+
+void Animation::bake(sf::Vector2u const &texture_size,
+                     sf::Vector2f const &origin) {
+  this->ownershipCheck();
+  ownership->texture_size_ = texture_size;
+  ownership->origin_ = origin;
+  ownership->is_baked_ = true;
+  ownership->quads_.resize(ownership->motions_.size());
+  for (usize i = 0; i < this->getAnimeCount(); ++i) { this->rebuild(i); }
+}
+
+bool Animation::isBaked() const {
+  this->ownershipCheck();
+  return ownership->is_baked_;
+}
+
+MotionQuad const *Animation::getQuads(usize const &anime_code) const {
+  this->codeCheck(anime_code);
+  this->bakeCheck();
+  return ownership->quads_.data() + ownership->offsets_[anime_code];
+}
+
+MotionQuad const &Animation::getQuad(usize const &anime_code,
+                                     usize const &motion_code) const {
+  this->codeCheck(anime_code, motion_code);
+  this->bakeCheck();
+  return ownership->quads_[ownership->offsets_[anime_code] + motion_code];
 }
 
 Motion const &Animation::getMotion(usize const &anime_code,
                                    usize const &motion_code) const {
   this->codeCheck(anime_code, motion_code);
-  return ownership->animes_[anime_code][motion_code];
+  return ownership->motions_[ownership->offsets_[anime_code] + motion_code];
 }
 
 void Animation::setMotion(usize const &anime_code,
                           usize const &motion_code,
                           Motion const &motion) {
   this->codeCheck(anime_code, motion_code);
-  ownership->animes_[anime_code][motion_code] = motion;
+  ownership->motions_[ownership->offsets_[anime_code] + motion_code] =
+      motion;
+  this->rebuild(anime_code);
 }
 
-Animation::Inner::Inner() {
+Animation::Inner::Inner()
+    : offsets_(1, 0),
+      texture_size_(),
+      origin_(),
+      is_baked_() {
 }
 
 Animation::Inner::Inner(Animation::Inner const &rhs) {
@@ -99,7 +201,15 @@ Animation::Inner::Inner(Animation::Inner const &rhs) {
 
 Animation::Inner &Animation::Inner::operator=(Animation::Inner const &rhs) {
   if (this == &rhs) { return *this; }
-  this->animes_.assign(rhs.animes_.begin(), rhs.animes_.end());
+  this->motions_.assign(rhs.motions_.begin(), rhs.motions_.end());
+  this->ends_.assign(rhs.ends_.begin(), rhs.ends_.end());
+  this->offsets_.assign(rhs.offsets_.begin(), rhs.offsets_.end());
+  this->frame_times_.assign(rhs.frame_times_.begin(),
+                            rhs.frame_times_.end());
+  this->quads_.assign(rhs.quads_.begin(), rhs.quads_.end());
+  this->texture_size_ = rhs.texture_size_;
+  this->origin_ = rhs.origin_;
+  this->is_baked_ = rhs.is_baked_;
   return *this;
 }
 
@@ -116,11 +226,95 @@ void Animation::ownershipCheck() const {
 void Animation::codeCheck(usize const &anime_code,
                           usize const &motion_code) const {
   this->ownershipCheck();
-  if (anime_code >= ownership->animes_.size()) {
+  if (anime_code + 1 >= ownership->offsets_.size()) {
     throw std::runtime_error("No exist anime_code.");
   } 
   if (motion_code != usize(-1) &&
-      motion_code >= ownership->animes_[anime_code].size()) {
+      motion_code >= ownership->offsets_[anime_code + 1] -
+                     ownership->offsets_[anime_code]) {
     throw std::runtime_error("No exist motion_code.");
   }
 }
+
+// grows or shrinks the anime at its end and shifts the ones after it
+void Animation::resizeAnime(usize const &anime_code,
+                            usize const &motion_count) {
+  Animation::Inner &inner = *ownership;
+  usize const &begin = inner.offsets_[anime_code];
+  usize const end = inner.offsets_[anime_code + 1];
+  usize const new_end = begin + motion_count;
+  if (new_end > end) {
+    inner.motions_.insert(inner.motions_.begin() + end, new_end - end,
+                          Motion());
+    inner.ends_.insert(inner.ends_.begin() + end, new_end - end,
+                       sf::Time::Zero);
+    if (inner.is_baked_) {
+      inner.quads_.insert(inner.quads_.begin() + end, new_end - end,
+                          MotionQuad());
+    }
+  } else if (new_end < end) {
+    inner.motions_.erase(inner.motions_.begin() + new_end,
+                         inner.motions_.begin() + end);
+    inner.ends_.erase(inner.ends_.begin() + new_end,
+                      inner.ends_.begin() + end);
+    if (inner.is_baked_) {
+      inner.quads_.erase(inner.quads_.begin() + new_end,
+                         inner.quads_.begin() + end);
+    }
+  }
+  for (usize i = anime_code + 1; i < inner.offsets_.size(); ++i) {
+    inner.offsets_[i] = inner.offsets_[i] + new_end - end;
+  }
+}
+
+void Animation::rebuild(usize const &anime_code) {
+  Animation::Inner &inner = *ownership;
+  usize const &begin = inner.offsets_[anime_code];
+  usize const &end = inner.offsets_[anime_code + 1];
+  sf::Time total = sf::Time::Zero;
+  bool is_uniform = (begin != end);
+  for (usize i = begin; i < end; ++i) {
+    total += inner.motions_[i].second;
+    inner.ends_[i] = total;
+    is_uniform = is_uniform &&
+                 inner.motions_[i].second == inner.motions_[begin].second;
+  }
+  inner.frame_times_[anime_code] =
+      (is_uniform && inner.motions_[begin].second > sf::Time::Zero) ?
+      inner.motions_[begin].second : sf::Time::Zero;
+  if (!inner.is_baked_) { return; }
+
+  // same corners sf::Sprite makes, a negative size flips the texcoords
+  sf::Vector2f const &origin = inner.origin_;
+  for (usize i = begin; i < end; ++i) {
+    sf::IntRect const &rect = inner.motions_[i].first;
+    i32 const left = std::min(rect.left, rect.left + rect.width);
+    i32 const top = std::min(rect.top, rect.top + rect.height);
+    if (left < 0 || top < 0 ||
+        left + std::abs(rect.width) > i32(inner.texture_size_.x) ||
+        top + std::abs(rect.height) > i32(inner.texture_size_.y)) {
+      throw std::runtime_error("Motion out of texture.");
+    }
+    f32 const width = f32(std::abs(rect.width));
+    f32 const height = f32(std::abs(rect.height));
+    f32 const u0 = f32(rect.left);
+    f32 const v0 = f32(rect.top);
+    f32 const u1 = u0 + rect.width;
+    f32 const v1 = v0 + rect.height;
+    MotionQuad &quad = inner.quads_[i];
+    quad.positions[0] = sf::Vector2f(0, 0) - origin;
+    quad.positions[1] = sf::Vector2f(width, 0) - origin;
+    quad.positions[2] = sf::Vector2f(width, height) - origin;
+    quad.positions[3] = sf::Vector2f(0, height) - origin;
+    quad.tex_coords[0] = sf::Vector2f(u0, v0);
+    quad.tex_coords[1] = sf::Vector2f(u1, v0);
+    quad.tex_coords[2] = sf::Vector2f(u1, v1);
+    quad.tex_coords[3] = sf::Vector2f(u0, v1);
+  }
+}
+
+void Animation::bakeCheck() const {
+  if (!ownership->is_baked_) {
+    throw std::runtime_error("No baked quads: Animation");
+  }
+}
@@ -0,0 +1,231 @@
+#include <lib/AnimationManager.h>
+
+#include <stdexcept>
+
+#include <lib/JobManager.h>
+
+std::vector<AnimationManager::Instance> AnimationManager::instances_;
+std::vector<usize> AnimationManager::instance_codes_;
+std::vector<usize> AnimationManager::instance_slots_;
+std::vector<usize> AnimationManager::free_instance_codes_;
+
+void AnimationManager::release() {
+  AnimationManager::instances_.clear();
+  AnimationManager::instance_codes_.clear();
+  AnimationManager::instance_slots_.clear();
+  AnimationManager::free_instance_codes_.clear();
+}
+
+usize AnimationManager::create(Animation const &animation,
+                               usize const &anime_code,
+                               AnimationManager::PlayMode const &mode,
+                               f32 const &speed) {
+  AnimationManager::speedCheck(speed);
+  Motion const *motions = animation.getMotions(anime_code);
+  usize instance_code;
+  if (AnimationManager::free_instance_codes_.empty()) {
+    instance_code = AnimationManager::instance_slots_.size();
+    AnimationManager::instance_slots_.push_back(usize(-1));
+  } else {
+    instance_code = AnimationManager::free_instance_codes_.back();
+    AnimationManager::free_instance_codes_.pop_back();
+  }
+  AnimationManager::instance_slots_[instance_code] =
+      AnimationManager::instances_.size();
+  AnimationManager::instances_.push_back(Instance({
+    motions, animation.isBaked() ? animation.getQuads(anime_code) : nullptr,
+    &animation, sf::Time::Zero, animation.getDuration(anime_code), speed,
+    u32(anime_code), 0, u32(animation.getMotionCount(anime_code)), u8(mode),
+    true,
+  }));
+  AnimationManager::instance_codes_.push_back(instance_code);
+  return instance_code;
+}
+
+void AnimationManager::destroy(usize const &instance_code) {
+  AnimationManager::codeCheck(instance_code);
+  usize index = AnimationManager::instance_slots_[instance_code];
+  usize last = AnimationManager::instances_.size() - 1;
+  if (index != last) {
+    AnimationManager::instances_[index] = AnimationManager::instances_[last];
+    AnimationManager::instance_codes_[index] =
+        AnimationManager::instance_codes_[last];
+    AnimationManager::instance_slots_[
+        AnimationManager::instance_codes_[index]] = index;
+  }
+  AnimationManager::instances_.pop_back();
+  AnimationManager::instance_codes_.pop_back();
+  AnimationManager::instance_slots_[instance_code] = usize(-1);
+  AnimationManager::free_instance_codes_.push_back(instance_code);
+}
+
+bool AnimationManager::isAlive(usize const &instance_code) noexcept {
+  return (instance_code < AnimationManager::instance_slots_.size() &&
+          AnimationManager::instance_slots_[instance_code] != usize(-1));
+}
+
+usize AnimationManager::getInstanceCount() noexcept {
+  return AnimationManager::instances_.size();
+}
+
+void AnimationManager::reserve(usize const &instance_count) {
+  AnimationManager::instances_.reserve(instance_count);
+  AnimationManager::instance_codes_.reserve(instance_count);
+  AnimationManager::instance_slots_.reserve(instance_count);
+}
+
+void AnimationManager::play(usize const &instance_code,
+                            usize const &anime_code,
+                            AnimationManager::PlayMode const &mode) {
+  Instance &instance = AnimationManager::getInstance(instance_code);
+  instance.motions_ = instance.animation_->getMotions(anime_code);
+  instance.quads_ = instance.animation_->isBaked() ?
+                    instance.animation_->getQuads(anime_code) : nullptr;
+  instance.motion_count_ = u32(
+      instance.animation_->getMotionCount(anime_code));
+  instance.elapsed_ = sf::Time::Zero;
+  instance.duration_ = instance.animation_->getDuration(anime_code);
+  instance.anime_code_ = u32(anime_code);
+  instance.motion_code_ = 0;
+  instance.mode_ = u8(mode);
+  instance.is_playing_ = true;
+}
+
+void AnimationManager::pause(usize const &instance_code) {
+  AnimationManager::getInstance(instance_code).is_playing_ = false;
+}
+
+void AnimationManager::resume(usize const &instance_code) {
+  AnimationManager::getInstance(instance_code).is_playing_ = true;
+}
+
+bool AnimationManager::isPlaying(usize const &instance_code) {
+  return AnimationManager::getInstance(instance_code).is_playing_;
+}
+
+usize AnimationManager::getAnimeCode(usize const &instance_code) {
+  return AnimationManager::getInstance(instance_code).anime_code_;
+}
+
+usize AnimationManager::getMotionCode(usize const &instance_code) {
+  return AnimationManager::getInstance(instance_code).motion_code_;
+}
+
+void AnimationManager::setMotionCode(usize const &instance_code,
+                                     usize const &motion_code) {
+  Instance &instance = AnimationManager::getInstance(instance_code);
+  if (motion_code >= instance.motion_count_) {
+    throw std::runtime_error("No exist motion_code.");
+  }
+  instance.motion_code_ = u32(motion_code);
+  instance.elapsed_ = sf::Time::Zero;
+  for (u32 i = 0; i < instance.motion_code_; ++i) {
+    instance.elapsed_ += instance.motions_[i].second;
+  }
+}
+
+AnimationManager::PlayMode AnimationManager::getPlayMode(
+    usize const &instance_code) {
+  return PlayMode(AnimationManager::getInstance(instance_code).mode_);
+}
+
+f32 const &AnimationManager::getSpeed(usize const &instance_code) {
+  return AnimationManager::getInstance(instance_code).speed_;
+}
+
+void AnimationManager::setSpeed(usize const &instance_code,
+                                f32 const &speed) {
+  AnimationManager::speedCheck(speed);
+  AnimationManager::getInstance(instance_code).speed_ = speed;
+}
+
+Motion const &AnimationManager::getMotion(usize const &instance_code) {
+  Instance const &instance = AnimationManager::getInstance(instance_code);
+  if (instance.motion_count_ == 0) {
+    throw std::runtime_error("No exist motion_code.");
+  }
+  return instance.motions_[instance.motion_code_];
+}
+
+sf::IntRect const &AnimationManager::getTextureRect(
+    usize const &instance_code) {
+  return AnimationManager::getMotion(instance_code).first;
+}
+
+MotionQuad const &AnimationManager::getQuad(usize const &instance_code) {
+  Instance const &instance = AnimationManager::getInstance(instance_code);
+  if (instance.quads_ == nullptr) {
+    throw std::runtime_error("No baked quads: Animation");
+  }
+  if (instance.motion_count_ == 0) {
+    throw std::runtime_error("No exist motion_code.");
+  }
+  return instance.quads_[instance.motion_code_];
+}
+
+void AnimationManager::advance(sf::Time const &dt) {
+  JobManager::parallelFor(0, AnimationManager::instances_.size(),
+                          kAdvanceGrain, [&dt](usize const &begin,
+                                               usize const &end) {
+    for (usize i = begin; i < end; ++i) {
+      AnimationManager::step(AnimationManager::instances_[i], dt);
+    }
+  });
+}
+
+void AnimationManager::codeCheck(usize const &instance_code) {
+  if (!AnimationManager::isAlive(instance_code)) {
+    throw std::runtime_error("No exist instance_code.");
+  }
+}
+
+void AnimationManager::speedCheck(f32 const &speed) {
+  if (!(speed >= 0.0f)) {
+    throw std::runtime_error("speed must not be negative.");
+  }
+}
+
+AnimationManager::Instance &AnimationManager::getInstance(
+    usize const &instance_code) {
+  AnimationManager::codeCheck(instance_code);
+  return AnimationManager::instances_[
+      AnimationManager::instance_slots_[instance_code]];
+}
+
+// a long dt costs one lookup however many motions it skips, motions
+// without duration are passed over and an anime without any holds
+void AnimationManager::step(AnimationManager::Instance &instance,
+                            sf::Time const &dt) {
+  if (!instance.is_playing_) { return; }
+  if (instance.motion_count_ == 0) { return; }
+  sf::Time const &duration = instance.duration_;
+  if (duration <= sf::Time::Zero) { return; }
+  Animation const &animation = *instance.animation_;
+  u32 const last = instance.motion_count_ - 1;
+  instance.elapsed_ += dt * instance.speed_;
+  if (instance.mode_ == kOnce) {
+    if (instance.elapsed_ >= duration) {
+      instance.elapsed_ = duration;
+      instance.motion_code_ = last;
+      instance.is_playing_ = false;
+      return;
+    }
+    instance.motion_code_ = u32(animation.getMotionCode(instance.anime_code_,
+                                                        instance.elapsed_));
+    return;
+  }
+  // ping-pong plays the inner motions once more backwards each cycle
+  sf::Time period = duration;
+  if (instance.mode_ == kPingPong && last > 0) {
+    period += duration - instance.motions_[0].second -
+              instance.motions_[last].second;
+  }
+  instance.elapsed_ = instance.elapsed_ % period;
+  sf::Time at = instance.elapsed_;
+  if (at >= duration) { // mirrored back, just short of the motion end
+    at = duration - instance.motions_[last].second - (at - duration) -
+         sf::microseconds(1);
+  }
+  instance.motion_code_ = u32(animation.getMotionCode(instance.anime_code_,
+                                                      at));
+}
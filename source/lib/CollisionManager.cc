@@ -0,0 +1,251 @@
+#include <lib/CollisionManager.h>
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+static constexpr f32 kMaxCellIndex = f32(1 << 30);
+
+f32 CollisionManager::cell_size_ = f32(CollisionManager::kDefaultCellSize);
+std::vector<CollisionManager::Collider> CollisionManager::colliders_;
+std::vector<usize> CollisionManager::free_codes_;
+std::unordered_map<u64, ColliderCodes> CollisionManager::cells_;
+u64 CollisionManager::query_stamp_ = u64(0);
+
+void CollisionManager::initialize(f32 const &cell_size) {
+  CollisionManager::release();
+  CollisionManager::setCellSize(cell_size);
+}
+
+void CollisionManager::release() {
+  CollisionManager::colliders_.clear();
+  CollisionManager::free_codes_.clear();
+  CollisionManager::cells_.clear();
+}
+
+f32 const &CollisionManager::getCellSize() noexcept {
+  return CollisionManager::cell_size_;
+}
+
+void CollisionManager::setCellSize(f32 const &cell_size) {
+  if (!(cell_size > 0.0f)) {
+    throw std::runtime_error("cell_size must be greater than 0.");
+  }
+  f32 previous = CollisionManager::cell_size_;
+  CollisionManager::cell_size_ = cell_size;
+  std::vector<CellRange> ranges(CollisionManager::colliders_.size());
+  try { // every range is checked before the grid is touched
+    for (usize i = 0; i < CollisionManager::colliders_.size(); ++i) {
+      Collider const &collider = CollisionManager::colliders_[i];
+      if (!collider.is_alive_) { continue; }
+      ranges[i] = CollisionManager::getCellRange(collider.bounds_);
+    }
+  } catch (...) {
+    CollisionManager::cell_size_ = previous;
+    throw;
+  }
+  CollisionManager::cells_.clear();
+  for (usize i = 0; i < CollisionManager::colliders_.size(); ++i) {
+    Collider &collider = CollisionManager::colliders_[i];
+    if (!collider.is_alive_) { continue; }
+    collider.cells_ = ranges[i];
+    CollisionManager::link(i);
+  }
+}
+
+usize CollisionManager::insert(ObjectManager::Handle const &handle,
+                               sf::FloatRect const &bounds) {
+  CellRange cells = CollisionManager::getCellRange(bounds);
+  usize collider_code;
+  if (CollisionManager::free_codes_.empty()) {
+    collider_code = CollisionManager::colliders_.size();
+    CollisionManager::colliders_.push_back(Collider());
+  } else {
+    collider_code = CollisionManager::free_codes_.back();
+    CollisionManager::free_codes_.pop_back();
+  }
+  Collider &collider = CollisionManager::colliders_[collider_code];
+  collider.handle_ = handle;
+  collider.bounds_ = bounds;
+  collider.cells_ = cells;
+  collider.query_stamp_ = 0;
+  collider.is_alive_ = true;
+  CollisionManager::link(collider_code);
+  return collider_code;
+}
+
+void CollisionManager::update(usize const &collider_code,
+                              sf::FloatRect const &bounds) {
+  CollisionManager::codeCheck(collider_code);
+  CellRange cells = CollisionManager::getCellRange(bounds);
+  Collider &collider = CollisionManager::colliders_[collider_code];
+  collider.bounds_ = bounds;
+  if (cells.left == collider.cells_.left &&
+      cells.top == collider.cells_.top &&
+      cells.right == collider.cells_.right &&
+      cells.bottom == collider.cells_.bottom) {
+    return;
+  }
+  CollisionManager::unlink(collider_code);
+  collider.cells_ = cells;
+  CollisionManager::link(collider_code);
+}
+
+void CollisionManager::remove(usize const &collider_code) {
+  CollisionManager::codeCheck(collider_code);
+  CollisionManager::unlink(collider_code);
+  CollisionManager::colliders_[collider_code].is_alive_ = false;
+  CollisionManager::free_codes_.push_back(collider_code);
+}
+
+bool CollisionManager::isAlive(usize const &collider_code) noexcept {
+  return (collider_code < CollisionManager::colliders_.size() &&
+          CollisionManager::colliders_[collider_code].is_alive_);
+}
+
+ObjectManager::Handle const &CollisionManager::getHandle(
+    usize const &collider_code) {
+  CollisionManager::codeCheck(collider_code);
+  return CollisionManager::colliders_[collider_code].handle_;
+}
+
+sf::FloatRect const &CollisionManager::getBounds(usize const &collider_code) {
+  CollisionManager::codeCheck(collider_code);
+  return CollisionManager::colliders_[collider_code].bounds_;
+}
+
+usize CollisionManager::getColliderCount() noexcept {
+  return (CollisionManager::colliders_.size() -
+          CollisionManager::free_codes_.size());
+}
+
+// a pair sharing several cells is only reported from the cell holding
+// the top left corner of its overlap, so no set is needed to dedupe
+void CollisionManager::queryPairs(ColliderPairs &pairs) {
+  pairs.clear();
+  f32 const &cell_size = CollisionManager::cell_size_;
+  for (auto const &cell : CollisionManager::cells_) {
+    ColliderCodes const &codes = cell.second;
+    for (usize i = 0; i < codes.size(); ++i) {
+      sf::FloatRect const &a = CollisionManager::colliders_[codes[i]].bounds_;
+      for (usize j = i + 1; j < codes.size(); ++j) {
+        sf::FloatRect const &b =
+            CollisionManager::colliders_[codes[j]].bounds_;
+        if (!(a.left < b.left + b.width && b.left < a.left + a.width &&
+              a.top < b.top + b.height && b.top < a.top + a.height)) {
+          continue;
+        }
+        i32 x = i32(std::floor(std::max(a.left, b.left) / cell_size));
+        i32 y = i32(std::floor(std::max(a.top, b.top) / cell_size));
+        if (CollisionManager::getCellKey(x, y) != cell.first) { continue; }
+        pairs.push_back(std::minmax(codes[i], codes[j]));
+      }
+    }
+  }
+}
+
+void CollisionManager::queryPoint(sf::Vector2f const &point,
+                                  ColliderCodes &codes) {
+  codes.clear();
+  f32 const &cell_size = CollisionManager::cell_size_;
+  f32 x = std::floor(point.x / cell_size);
+  f32 y = std::floor(point.y / cell_size);
+  if (!(std::abs(x) < kMaxCellIndex && std::abs(y) < kMaxCellIndex)) {
+    return; // no collider lives that far out
+  }
+  auto cell = CollisionManager::cells_.find(
+      CollisionManager::getCellKey(i32(x), i32(y)));
+  if (cell == CollisionManager::cells_.end()) { return; }
+  for (usize const &collider_code : cell->second) {
+    sf::FloatRect const &bounds =
+        CollisionManager::colliders_[collider_code].bounds_;
+    if (bounds.left <= point.x && point.x < bounds.left + bounds.width &&
+        bounds.top <= point.y && point.y < bounds.top + bounds.height) {
+      codes.push_back(collider_code);
+    }
+  }
+}
+
+void CollisionManager::queryRect(sf::FloatRect const &rect,
+                                 ColliderCodes &codes) {
+  codes.clear();
+  u64 const stamp = ++CollisionManager::query_stamp_;
+  CellRange cells = CollisionManager::getCellRange(rect);
+  for (i32 y = cells.top; y <= cells.bottom; ++y) {
+    for (i32 x = cells.left; x <= cells.right; ++x) {
+      auto cell = CollisionManager::cells_.find(
+          CollisionManager::getCellKey(x, y));
+      if (cell == CollisionManager::cells_.end()) { continue; }
+      for (usize const &collider_code : cell->second) {
+        Collider &collider = CollisionManager::colliders_[collider_code];
+        if (collider.query_stamp_ == stamp) { continue; }
+        collider.query_stamp_ = stamp;
+        sf::FloatRect const &bounds = collider.bounds_;
+        if (rect.left < bounds.left + bounds.width &&
+            bounds.left < rect.left + rect.width &&
+            rect.top < bounds.top + bounds.height &&
+            bounds.top < rect.top + rect.height) {
+          codes.push_back(collider_code);
+        }
+      }
+    }
+  }
+}
+
+void CollisionManager::codeCheck(usize const &collider_code) {
+  if (!CollisionManager::isAlive(collider_code)) {
+    throw std::runtime_error("No exist collider_code.");
+  }
+}
+
+// a nan or far away aabb would overflow i32 or link millions of cells
+CollisionManager::CellRange CollisionManager::getCellRange(
+    sf::FloatRect const &bounds) {
+  f32 const &cell_size = CollisionManager::cell_size_;
+  f32 left = std::floor(bounds.left / cell_size);
+  f32 top = std::floor(bounds.top / cell_size);
+  f32 right = std::floor((bounds.left + bounds.width) / cell_size);
+  f32 bottom = std::floor((bounds.top + bounds.height) / cell_size);
+  if (!(std::abs(left) < kMaxCellIndex && std::abs(top) < kMaxCellIndex &&
+        std::abs(right) < kMaxCellIndex && std::abs(bottom) < kMaxCellIndex)) {
+    throw std::runtime_error("bounds are out of range.");
+  }
+  if (right - left >= f32(CollisionManager::kMaxCellSpan) ||
+      bottom - top >= f32(CollisionManager::kMaxCellSpan)) {
+    throw std::runtime_error("bounds span too many cells.");
+  }
+  return CellRange({ i32(left), i32(top), i32(right), i32(bottom) });
+}
+
+u64 CollisionManager::getCellKey(i32 const &x, i32 const &y) noexcept {
+  return u64(u32(x)) << 32 | u64(u32(y));
+}
+
+void CollisionManager::link(usize const &collider_code) {
+  CellRange const &cells = CollisionManager::colliders_[collider_code].cells_;
+  for (i32 y = cells.top; y <= cells.bottom; ++y) {
+    for (i32 x = cells.left; x <= cells.right; ++x) {
+      CollisionManager::cells_[CollisionManager::getCellKey(x, y)]
+          .push_back(collider_code);
+    }
+  }
+}
+
+// emptied cells are erased, so the map and queryPairs only ever cover
+// occupied cells however far colliders roam
+void CollisionManager::unlink(usize const &collider_code) {
+  CellRange const &cells = CollisionManager::colliders_[collider_code].cells_;
+  for (i32 y = cells.top; y <= cells.bottom; ++y) {
+    for (i32 x = cells.left; x <= cells.right; ++x) {
+      auto cell = CollisionManager::cells_.find(
+          CollisionManager::getCellKey(x, y));
+      if (cell == CollisionManager::cells_.end()) { continue; }
+      ColliderCodes &codes = cell->second;
+      auto found = std::find(codes.begin(), codes.end(), collider_code);
+      if (found == codes.end()) { continue; }
+      *found = codes.back();
+      codes.pop_back();
+      if (codes.empty()) { CollisionManager::cells_.erase(cell); }
+    }
+  }
+}
@@ -1,7 +1,10 @@
 #include <lib/FPSManager.h>
 
+#include <stdexcept>
+#include <algorithm>
 #include <thread>
 
+#include <SFML/System/Sleep.hpp>
 #include <SFML/System/Time.hpp>
 
 using f64 = double;
@@ -9,9 +12,25 @@ using DurationNano = std::chrono::duration<u64, std::nano>;
 
 static constexpr u64 kSecondUnit = 1000000; // us
 static constexpr u64 kSleepUnit = 100000;   // ns
+static constexpr u64 kCalibrateSleep = 1000; // us
+static constexpr usize kCalibrateCount = 16;
+static constexpr usize kCalibrateRank = 75;  // percentile, %
+static constexpr u64 kSpinMargin = 200;      // us
+static constexpr i64 kSleepAverage = 8;      // frames
+static constexpr usize kHistoryCapacity = 1024;
+static constexpr usize kStatsWindow = 240;
 
-std::list<u64> FPSManager::time_per_frame_;
+std::vector<u64> FPSManager::time_per_frame_(kHistoryCapacity);
+std::vector<u64> FPSManager::stats_buffer_(kHistoryCapacity);
+usize FPSManager::head_           = usize(0);
+usize FPSManager::size_           = usize(0);
+usize FPSManager::second_count_   = usize(0);
+usize FPSManager::stats_window_   = kStatsWindow;
 sf::Clock FPSManager::clock_;
+FPSManager::PacingMode FPSManager::pacing_mode_ = FPSManager::kPolling;
+bool FPSManager::is_calibrated_   = false;
+u64 FPSManager::sleep_granularity_ = u64(0);
+i64 FPSManager::pacing_error_     = i64(0);
 u64 FPSManager::framerate_limit_  = u64(-1);
 u64 FPSManager::term_             = kSecondUnit / FPSManager::framerate_limit_;
 u64 FPSManager::remain_           = kSecondUnit % FPSManager::framerate_limit_;
@@ -21,7 +40,12 @@ u64 FPSManager::add_              = u64(0);
 u64 FPSManager::target_           = u64(0);
 
 u64 FPSManager::getCurrentFPS() noexcept {
-  return FPSManager::time_per_frame_.size();
+  usize capacity = FPSManager::time_per_frame_.size();
+  if (FPSManager::second_count_ < capacity) {
+    return FPSManager::second_count_;
+  }
+  u64 span = FPSManager::getHistory(0) - FPSManager::getHistory(capacity - 1);
+  return (span != 0 ? (capacity - 1) * kSecondUnit / span : u64(-1));
 }
 
 u64 const &FPSManager::getFramerateLimit() noexcept {
@@ -29,7 +53,7 @@ u64 const &FPSManager::getFramerateLimit() noexcept {
 }
 
 void FPSManager::setFramerateLimit(u64 const &framerate_limit) noexcept {
-  FPSManager::time_per_frame_.clear();
+  FPSManager::clearHistory();
   FPSManager::clock_.restart();
   FPSManager::framerate_limit_  = (framerate_limit != 0 ?
                                    framerate_limit :
@@ -42,20 +66,160 @@ void FPSManager::setFramerateLimit(u64 const &framerate_limit) noexcept {
   FPSManager::target_           = u64(0);
 }
 
+FPSManager::PacingMode const &FPSManager::getPacingMode() noexcept {
+  return FPSManager::pacing_mode_;
+}
+
+void FPSManager::setPacingMode(FPSManager::PacingMode const &pacing_mode) {
+  if (pacing_mode >= FPSManager::kPacingModeCount) {
+    throw std::runtime_error("No exist pacing_mode.");
+  }
+  FPSManager::pacing_mode_ = pacing_mode;
+  if (pacing_mode == FPSManager::kHybrid && !FPSManager::is_calibrated_) {
+    FPSManager::calibrateSleep();
+  }
+}
+
+// sf::sleep raises the timer resolution on windows while it sleeps, a
+// percentile keeps one preempted sample from setting the guard
+void FPSManager::calibrateSleep() noexcept {
+  u64 overshoots[kCalibrateCount];
+  for (usize i = 0; i < kCalibrateCount; ++i) {
+    u64 begin = u64(FPSManager::clock_.getElapsedTime().asMicroseconds());
+    sf::sleep(sf::microseconds(kCalibrateSleep));
+    u64 end = u64(FPSManager::clock_.getElapsedTime().asMicroseconds());
+    u64 slept = end - begin;
+    overshoots[i] = (slept > kCalibrateSleep ? slept - kCalibrateSleep : 0);
+  }
+  u64 *nth = overshoots + ((kCalibrateCount * kCalibrateRank + 99) / 100 - 1);
+  std::nth_element(overshoots, nth, overshoots + kCalibrateCount);
+  FPSManager::sleep_granularity_ = *nth;
+  FPSManager::is_calibrated_ = true;
+}
+
+u64 const &FPSManager::getSleepGranularity() noexcept {
+  return FPSManager::sleep_granularity_;
+}
+
+i64 const &FPSManager::getPacingError() noexcept {
+  return FPSManager::pacing_error_;
+}
+
+usize FPSManager::getHistoryCapacity() noexcept {
+  return FPSManager::time_per_frame_.size();
+}
+
+void FPSManager::setHistoryCapacity(usize const &history_capacity) {
+  if (history_capacity < 2) {
+    throw std::runtime_error("history_capacity must be at least 2.");
+  }
+  FPSManager::time_per_frame_.assign(history_capacity, u64(0));
+  FPSManager::stats_buffer_.assign(history_capacity, u64(0));
+  FPSManager::clearHistory();
+}
+
+usize const &FPSManager::getStatsWindow() noexcept {
+  return FPSManager::stats_window_;
+}
+
+void FPSManager::setStatsWindow(usize const &stats_window) noexcept {
+  FPSManager::stats_window_ = stats_window;
+}
+
+FPSManager::FrameStats FPSManager::getFrameStats() noexcept {
+  FrameStats stats = FrameStats();
+  if (FPSManager::size_ < 2) { return stats; }
+  usize count = std::min(FPSManager::stats_window_, FPSManager::size_ - 1);
+  if (count == 0) { return stats; }
+  u64 *begin = FPSManager::stats_buffer_.data();
+  u64 *end = begin + count;
+  u64 total = 0;
+  for (usize i = 0; i < count; ++i) {
+    begin[i] = FPSManager::getHistory(i) - FPSManager::getHistory(i + 1);
+    total += begin[i];
+  }
+  auto nearestRank = [&](usize const &percent) -> u64 {
+    u64 *nth = begin + ((count * percent + 99) / 100 - 1);
+    std::nth_element(begin, nth, end);
+    return *nth;
+  };
+  stats.sample_count = count;
+  stats.mean = total / count;
+  stats.p50 = nearestRank(50);
+  stats.p95 = nearestRank(95);
+  stats.p99 = nearestRank(99);
+  stats.min = *std::min_element(begin, end);
+  stats.max = *std::max_element(begin, end);
+  return stats;
+}
+
 void FPSManager::framePulse() noexcept {
   FPSManager::add_ += FPSManager::add_per_frame_;
   FPSManager::target_ += FPSManager::term_ + FPSManager::add_ / kSecondUnit;
   FPSManager::add_ %= kSecondUnit;
+  u64 now = (FPSManager::pacing_mode_ == FPSManager::kHybrid ?
+             FPSManager::sleepSpinUntil(FPSManager::target_) :
+             FPSManager::pollUntil(FPSManager::target_));
+  FPSManager::pacing_error_ = i64(now) - i64(FPSManager::target_);
+  FPSManager::target_ = now;
+  FPSManager::pushHistory(now);
+}
+
+u64 FPSManager::pollUntil(u64 const &target) noexcept {
   u64 now;
   while (true) {
     now = u64(FPSManager::clock_.getElapsedTime().asMicroseconds());
-    if (now >= FPSManager::target_) { break; }
+    if (now >= target) { break; }
     std::this_thread::sleep_for(DurationNano(kSleepUnit));
   }
-  FPSManager::target_ = now;
-  FPSManager::time_per_frame_.push_back(now);
+  return now;
+}
+
+// the guard stays under half a frame so some of every frame is slept, and
+// follows a moving average of how late each sleep wakes
+u64 FPSManager::sleepSpinUntil(u64 const &target) noexcept {
+  u64 guard = std::min(FPSManager::sleep_granularity_ + kSpinMargin,
+                       FPSManager::term_ / 2);
+  u64 now = u64(FPSManager::clock_.getElapsedTime().asMicroseconds());
+  if (target > now + guard) {
+    u64 wake = target - guard;
+    sf::sleep(sf::microseconds(i64(wake - now)));
+    now = u64(FPSManager::clock_.getElapsedTime().asMicroseconds());
+    i64 overshoot = i64(std::min(now > wake ? now - wake : 0,
+                                 FPSManager::term_ / 2));
+    FPSManager::sleep_granularity_ = u64(
+        i64(FPSManager::sleep_granularity_) +
+        (overshoot - i64(FPSManager::sleep_granularity_)) / kSleepAverage);
+  }
+  while (now < target) {
+    std::this_thread::yield();
+    now = u64(FPSManager::clock_.getElapsedTime().asMicroseconds());
+  }
+  return now;
+}
+
+void FPSManager::clearHistory() noexcept {
+  FPSManager::head_ = 0;
+  FPSManager::size_ = 0;
+  FPSManager::second_count_ = 0;
+}
+
+void FPSManager::pushHistory(u64 const &now) noexcept {
+  usize capacity = FPSManager::time_per_frame_.size();
+  FPSManager::time_per_frame_[FPSManager::head_] = now;
+  FPSManager::head_ = (FPSManager::head_ + 1) % capacity;
+  FPSManager::size_ = std::min(FPSManager::size_ + 1, capacity);
+  FPSManager::second_count_ = std::min(FPSManager::second_count_ + 1,
+                                       FPSManager::size_);
   u64 cutline = (now >= kSecondUnit ? now - kSecondUnit : u64(0));
-  while (FPSManager::time_per_frame_.front() <= cutline) {
-    FPSManager::time_per_frame_.pop_front();
+  while (FPSManager::second_count_ != 0 &&
+         FPSManager::getHistory(FPSManager::second_count_ - 1) <= cutline) {
+    --FPSManager::second_count_;
   }
 }
+
+u64 const &FPSManager::getHistory(usize const &age) noexcept {
+  usize capacity = FPSManager::time_per_frame_.size();
+  return FPSManager::time_per_frame_[
+      (FPSManager::head_ + capacity - 1 - age) % capacity];
+}
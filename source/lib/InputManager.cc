@@ -0,0 +1,101 @@
+#include <lib/InputManager.h>
+
+#include <lib/InputRecorder.h>
+#include <lib/KeyManager.h>
+#include <lib/MouseManager.h>
+
+sf::Clock InputManager::clock_;
+std::unique_ptr<InputEvent[]> InputManager::events_(
+    new InputEvent[InputManager::kQueueCapacity]);
+std::atomic<usize> InputManager::head_(0);
+std::atomic<usize> InputManager::tail_(0);
+std::atomic<usize> InputManager::dropped_count_(0);
+std::atomic<i64> InputManager::latency_(0);
+
+void InputManager::initialize() {
+  InputManager::clock_.restart();
+  InputManager::head_ = 0;
+  InputManager::tail_ = 0;
+  InputManager::dropped_count_ = 0;
+  InputManager::latency_ = 0;
+}
+
+sf::Time InputManager::getTime() {
+  return InputManager::clock_.getElapsedTime();
+}
+
+bool InputManager::push(sf::Event const &event) {
+  return InputManager::push(event, InputManager::getTime());
+}
+
+bool InputManager::push(sf::Event const &event, sf::Time const &time) {
+  usize tail = InputManager::tail_.load(std::memory_order_relaxed);
+  if (tail - InputManager::head_.load(std::memory_order_acquire) >=
+      InputManager::kQueueCapacity) {
+    InputManager::dropped_count_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  InputManager::events_[tail & (InputManager::kQueueCapacity - 1)] =
+      InputEvent({ event, time });
+  InputManager::tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+bool InputManager::pop(InputEvent &input_event) {
+  usize head = InputManager::head_.load(std::memory_order_relaxed);
+  if (head == InputManager::tail_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  input_event =
+      InputManager::events_[head & (InputManager::kQueueCapacity - 1)];
+  InputManager::head_.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+// later events wait in the ring for the tick that covers their time
+usize InputManager::dispatch(sf::Time const &until, u64 const &tick) {
+  usize count = 0;
+  while (true) {
+    usize head = InputManager::head_.load(std::memory_order_relaxed);
+    if (head == InputManager::tail_.load(std::memory_order_acquire)) {
+      break;
+    }
+    InputEvent const &input_event =
+        InputManager::events_[head & (InputManager::kQueueCapacity - 1)];
+    if (input_event.time > until) { break; }
+    sf::Event const event = input_event.event;
+    InputManager::latency_.store(
+        (InputManager::getTime() - input_event.time).asMicroseconds(),
+        std::memory_order_relaxed);
+    InputManager::head_.store(head + 1, std::memory_order_release);
+
+    InputRecorder::capture(tick, event);
+    InputManager::process(event);
+    ++count;
+  }
+  return count;
+}
+
+void InputManager::process(sf::Event const &event) {
+  if (event.type >= sf::Event::KeyPressed &&
+      event.type <= sf::Event::KeyReleased) {
+    KeyManager::eventProcess(event);
+  } else if (event.type >= sf::Event::MouseWheelScrolled &&
+             event.type <= sf::Event::MouseLeft) {
+    MouseManager::eventProcess(event);
+  }
+}
+
+usize InputManager::getEventCount() noexcept {
+  usize head = InputManager::head_.load(std::memory_order_acquire);
+  return InputManager::tail_.load(std::memory_order_acquire) - head;
+}
+
+usize InputManager::getDroppedCount() noexcept {
+  return InputManager::dropped_count_.load(std::memory_order_relaxed);
+}
+
+sf::Time InputManager::getLatency() noexcept {
+  return sf::microseconds(
+      InputManager::latency_.load(std::memory_order_relaxed));
+}
@@ -0,0 +1,283 @@
+#include <lib/InputRecorder.h>
+
+#include <stdexcept>
+#include <cstring>
+#include <fstream>
+
+#include <lib/InputManager.h>
+
+using i32 = int;
+using i64 = long long;
+using u8 = unsigned char;
+using u32 = unsigned int;
+using f32 = float;
+
+static constexpr u32 kRecordMagic = 0x52494653; // "SFIR"
+static constexpr u32 kRecordVersion = 3;
+static constexpr u64 kMinRecordBytes = 2; // tick delta and type
+
+// key events keep their modifiers in one byte
+enum {
+  kAlt = 1 << 0,
+  kControl = 1 << 1,
+  kShift = 1 << 2,
+  kSystem = 1 << 3,
+};
+
+// base 128, low groups first, most ticks and moves take a byte or two
+static void writeVarint(std::ostream &out, u64 value) {
+  while (value >= 0x80) {
+    out.put(char(u8(value) | 0x80));
+    value >>= 7;
+  }
+  out.put(char(u8(value)));
+}
+
+static void writeSigned(std::ostream &out, i64 const &value) {
+  writeVarint(out, u64(value) << 1 ^ u64(value >> 63));
+}
+
+static void writeF32(std::ostream &out, f32 const &value) {
+  u32 bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  u8 bytes[4] = {
+    u8(bits), u8(bits >> 8), u8(bits >> 16), u8(bits >> 24),
+  };
+  out.write(reinterpret_cast<char const *>(bytes), sizeof(bytes));
+}
+
+static u8 readU8(std::istream &in) {
+  char byte;
+  if (!in.get(byte)) {
+    throw std::runtime_error("input record truncated");
+  }
+  return u8(byte);
+}
+
+static u64 readVarint(std::istream &in) {
+  u64 value = 0;
+  for (u32 shift = 0; shift < 64; shift += 7) {
+    u8 byte = readU8(in);
+    value |= u64(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) { return value; }
+  }
+  throw std::runtime_error("broken input record");
+}
+
+static i64 readSigned(std::istream &in) {
+  u64 value = readVarint(in);
+  return i64(value >> 1 ^ (~(value & 1) + 1));
+}
+
+static u64 remainingBytes(std::istream &in) {
+  std::streampos position = in.tellg();
+  in.seekg(0, std::ios::end);
+  std::streampos end = in.tellg();
+  in.seekg(position);
+  if (position < 0 || end < position) {
+    throw std::runtime_error("input record unreadable");
+  }
+  return u64(end - position);
+}
+
+static f32 readF32(std::istream &in) {
+  u32 bits = 0;
+  for (u32 shift = 0; shift < 32; shift += 8) {
+    bits |= u32(readU8(in)) << shift;
+  }
+  f32 value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+InputRecorder::Mode InputRecorder::mode_ = InputRecorder::kIdle;
+u64 InputRecorder::tick_rate_ = u64(0);
+u64 InputRecorder::tick_count_ = u64(0);
+u64 InputRecorder::fed_tick_count_ = u64(0);
+std::vector<InputRecorder::Record> InputRecorder::records_;
+usize InputRecorder::cursor_ = usize(0);
+
+void InputRecorder::record(u64 const &tick_rate) {
+  InputRecorder::records_.clear();
+  InputRecorder::tick_rate_ = tick_rate;
+  InputRecorder::tick_count_ = 0;
+  InputRecorder::cursor_ = 0;
+  InputRecorder::mode_ = InputRecorder::kRecording;
+}
+
+void InputRecorder::replay() {
+  InputRecorder::cursor_ = 0;
+  InputRecorder::fed_tick_count_ = 0;
+  InputRecorder::mode_ = InputRecorder::kReplaying;
+}
+
+void InputRecorder::stop() noexcept {
+  InputRecorder::mode_ = InputRecorder::kIdle;
+}
+
+InputRecorder::Mode const &InputRecorder::getMode() noexcept {
+  return InputRecorder::mode_;
+}
+
+bool InputRecorder::isRecording() noexcept {
+  return InputRecorder::mode_ == InputRecorder::kRecording;
+}
+
+bool InputRecorder::isReplaying() noexcept {
+  return InputRecorder::mode_ == InputRecorder::kReplaying;
+}
+
+bool InputRecorder::isFinished() noexcept {
+  return (InputRecorder::mode_ == InputRecorder::kReplaying &&
+          InputRecorder::cursor_ == InputRecorder::records_.size() &&
+          InputRecorder::fed_tick_count_ >= InputRecorder::tick_count_);
+}
+
+u64 const &InputRecorder::getTickRate() noexcept {
+  return InputRecorder::tick_rate_;
+}
+
+u64 const &InputRecorder::getTickCount() noexcept {
+  return InputRecorder::tick_count_;
+}
+
+void InputRecorder::setTickCount(u64 const &tick_count) noexcept {
+  InputRecorder::tick_count_ = tick_count;
+}
+
+usize InputRecorder::getEventCount() noexcept {
+  return InputRecorder::records_.size();
+}
+
+void InputRecorder::capture(u64 const &tick, sf::Event const &event) {
+  if (InputRecorder::mode_ != InputRecorder::kRecording) { return; }
+  InputRecorder::records_.push_back(Record({ tick, event }));
+}
+
+// a record for a tick already gone still runs, on the first tick after
+usize InputRecorder::feed(u64 const &tick) {
+  if (InputRecorder::mode_ != InputRecorder::kReplaying) { return 0; }
+  InputRecorder::fed_tick_count_ = tick + 1;
+  usize count = 0;
+  while (InputRecorder::cursor_ < InputRecorder::records_.size() &&
+         InputRecorder::records_[InputRecorder::cursor_].tick_ <= tick) {
+    InputManager::process(
+        InputRecorder::records_[InputRecorder::cursor_++].event_);
+    ++count;
+  }
+  return count;
+}
+
+void InputRecorder::loadFromFile(std::string const &filename) {
+  std::ifstream in(filename, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error(std::string("load from file failed: ") + filename);
+  }
+  u32 magic = 0;
+  for (u32 shift = 0; shift < 32; shift += 8) {
+    magic |= u32(readU8(in)) << shift;
+  }
+  if (magic != kRecordMagic) {
+    throw std::runtime_error(std::string("not an input record: ") + filename);
+  }
+  if (readVarint(in) != kRecordVersion) {
+    throw std::runtime_error(std::string("unknown input record version: ") +
+                             filename);
+  }
+  u64 tick_rate = readVarint(in);
+  u64 tick_count = readVarint(in);
+  u64 record_count = readVarint(in);
+  if (record_count > remainingBytes(in) / kMinRecordBytes) {
+    throw std::runtime_error(std::string("input record truncated: ") +
+                             filename);
+  }
+  std::vector<Record> records(record_count);
+  u64 tick = 0;
+  for (Record &record : records) {
+    tick += readVarint(in);
+    record.tick_ = tick;
+    sf::Event &event = record.event_;
+    std::memset(&event, 0, sizeof(event));
+    event.type = sf::Event::EventType(readU8(in));
+    if (event.type == sf::Event::KeyPressed ||
+        event.type == sf::Event::KeyReleased) {
+      event.key.code = sf::Keyboard::Key(readSigned(in));
+      event.key.scancode = decltype(event.key.scancode)(readSigned(in));
+      u8 modifiers = readU8(in);
+      event.key.alt = (modifiers & kAlt) != 0;
+      event.key.control = (modifiers & kControl) != 0;
+      event.key.shift = (modifiers & kShift) != 0;
+      event.key.system = (modifiers & kSystem) != 0;
+    } else if (event.type == sf::Event::MouseWheelScrolled) {
+      event.mouseWheelScroll.wheel = sf::Mouse::Wheel(readU8(in));
+      event.mouseWheelScroll.delta = readF32(in);
+      event.mouseWheelScroll.x = i32(readSigned(in));
+      event.mouseWheelScroll.y = i32(readSigned(in));
+    } else if (event.type == sf::Event::MouseButtonPressed ||
+               event.type == sf::Event::MouseButtonReleased) {
+      event.mouseButton.button = sf::Mouse::Button(readU8(in));
+      event.mouseButton.x = i32(readSigned(in));
+      event.mouseButton.y = i32(readSigned(in));
+    } else if (event.type == sf::Event::MouseMoved) {
+      event.mouseMove.x = i32(readSigned(in));
+      event.mouseMove.y = i32(readSigned(in));
+    } else if (event.type != sf::Event::MouseEntered &&
+               event.type != sf::Event::MouseLeft) {
+      throw std::runtime_error(std::string("broken input record: ") +
+                               filename);
+    }
+  }
+  InputRecorder::mode_ = InputRecorder::kIdle;
+  InputRecorder::tick_rate_ = tick_rate;
+  InputRecorder::tick_count_ = tick_count;
+  InputRecorder::records_.swap(records);
+  InputRecorder::cursor_ = 0;
+}
+
+// magic, version, tick rate, tick count, event count, then per event the
+// tick delta, the type and only the fields its type uses
+void InputRecorder::saveToFile(std::string const &filename) {
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("save to file failed");
+  }
+  for (u32 shift = 0; shift < 32; shift += 8) {
+    out.put(char(u8(kRecordMagic >> shift)));
+  }
+  writeVarint(out, kRecordVersion);
+  writeVarint(out, InputRecorder::tick_rate_);
+  writeVarint(out, InputRecorder::tick_count_);
+  writeVarint(out, InputRecorder::records_.size());
+  u64 tick = 0;
+  for (Record const &record : InputRecorder::records_) {
+    sf::Event const &event = record.event_;
+    writeVarint(out, record.tick_ - tick);
+    tick = record.tick_;
+    out.put(char(u8(event.type)));
+    if (event.type == sf::Event::KeyPressed ||
+        event.type == sf::Event::KeyReleased) {
+      writeSigned(out, i64(event.key.code));
+      writeSigned(out, i64(event.key.scancode));
+      out.put(char(u8((event.key.alt ? kAlt : 0) |
+                      (event.key.control ? kControl : 0) |
+                      (event.key.shift ? kShift : 0) |
+                      (event.key.system ? kSystem : 0))));
+    } else if (event.type == sf::Event::MouseWheelScrolled) {
+      out.put(char(u8(event.mouseWheelScroll.wheel)));
+      writeF32(out, event.mouseWheelScroll.delta);
+      writeSigned(out, event.mouseWheelScroll.x);
+      writeSigned(out, event.mouseWheelScroll.y);
+    } else if (event.type == sf::Event::MouseButtonPressed ||
+               event.type == sf::Event::MouseButtonReleased) {
+      out.put(char(u8(event.mouseButton.button)));
+      writeSigned(out, event.mouseButton.x);
+      writeSigned(out, event.mouseButton.y);
+    } else if (event.type == sf::Event::MouseMoved) {
+      writeSigned(out, event.mouseMove.x);
+      writeSigned(out, event.mouseMove.y);
+    } // entering and leaving carry nothing but the type
+  }
+  if (!out) {
+    throw std::runtime_error("save to file failed");
+  }
+}
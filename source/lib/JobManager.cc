@@ -0,0 +1,239 @@
+#include <lib/JobManager.h>
+
+#include <stdexcept>
+#include <algorithm>
+#include <exception>
+
+std::vector<std::unique_ptr<JobManager::Deque>> JobManager::deques_;
+std::vector<std::thread> JobManager::workers_;
+std::atomic<usize> JobManager::pending_(0);
+std::atomic<usize> JobManager::sleeping_(0);
+std::atomic<bool> JobManager::is_running_(false);
+std::mutex JobManager::mutex_;
+std::condition_variable JobManager::condition_;
+thread_local usize JobManager::worker_code_ = usize(-1);
+
+void JobManager::initialize(usize const &worker_count) {
+  JobManager::release();
+  usize count = worker_count;
+  if (count == 0) {
+    count = std::max(std::thread::hardware_concurrency(), 1u) - 1;
+  }
+  for (usize i = 0; i <= count; ++i) {
+    JobManager::deques_.emplace_back(new JobManager::Deque());
+  }
+  JobManager::worker_code_ = 0;
+  JobManager::is_running_ = true;
+  for (usize i = 1; i <= count; ++i) {
+    JobManager::workers_.emplace_back(JobManager::workerLoop, i);
+  }
+}
+
+// jobs still queued run here so no counter is left hanging
+void JobManager::release() {
+  if (!JobManager::is_running_) { return; }
+  {
+    std::lock_guard<std::mutex> lock(JobManager::mutex_);
+    JobManager::is_running_ = false;
+  }
+  JobManager::condition_.notify_all();
+  for (std::thread &worker : JobManager::workers_) { worker.join(); }
+  JobManager::workers_.clear();
+  while (Task *task = JobManager::findTask(JobManager::worker_code_)) {
+    JobManager::execute(task);
+  }
+  JobManager::deques_.clear();
+  JobManager::worker_code_ = usize(-1);
+}
+
+bool JobManager::isRunning() noexcept {
+  return JobManager::is_running_;
+}
+
+usize JobManager::getWorkerCount() noexcept {
+  return std::max(JobManager::deques_.size(), usize(1));
+}
+
+// threads outside the pool own no deque and run the job themselves
+void JobManager::run(Job const &job, JobCounter *const &counter) {
+  if (counter != nullptr) { counter->fetch_add(1); }
+  Task *task = new Task({ job, counter });
+  usize const &worker_code = JobManager::worker_code_;
+  if (!JobManager::is_running_ || worker_code == usize(-1) ||
+      !JobManager::deques_[worker_code]->push(task)) {
+    JobManager::execute(task);
+    return;
+  }
+  JobManager::pending_.fetch_add(1);
+  if (JobManager::sleeping_.load() > 0) {
+    { std::lock_guard<std::mutex> lock(JobManager::mutex_); }
+    JobManager::condition_.notify_one();
+  }
+}
+
+void JobManager::wait(JobCounter const &counter) {
+  while (counter.load(std::memory_order_acquire) > 0) {
+    Task *task = JobManager::is_running_ ?
+                 JobManager::findTask(JobManager::worker_code_) : nullptr;
+    if (task != nullptr) {
+      JobManager::execute(task);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void JobManager::parallelFor(usize const &begin,
+                             usize const &end,
+                             usize const &grain,
+                             RangeJob const &job) {
+  if (begin >= end) { return; }
+  usize const count = end - begin;
+  usize chunk = grain;
+  if (chunk == 0) {
+    usize chunk_count = JobManager::getWorkerCount() * 4;
+    chunk = std::max((count + chunk_count - 1) / chunk_count, usize(1));
+  }
+  if (!JobManager::is_running_ || chunk >= count) {
+    job(begin, end);
+    return;
+  }
+  // chunks point into this frame, so nothing leaves it before every chunk
+  // is done, the first exception any of them threw is rethrown after
+  JobCounter counter(0);
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  RangeJob const guarded = [&](usize const &from, usize const &to) {
+    try {
+      job(from, to);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) { error = std::current_exception(); }
+    }
+  };
+  usize from = begin;
+  for (; end - from > chunk; from += chunk) {
+    usize const to = from + chunk;
+    JobManager::run([&guarded, from, to]() { guarded(from, to); }, &counter);
+  }
+  guarded(from, end); // the last chunk on this thread
+  while (true) {
+    try {
+      JobManager::wait(counter);
+      break;
+    } catch (...) { // from another job this thread helped with
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if (!error) { error = std::current_exception(); }
+    }
+  }
+  if (error) { std::rethrow_exception(error); }
+}
+
+JobManager::Deque::Deque()
+    : top_(0),
+      bottom_(0),
+      tasks_(new std::atomic<Task *>[JobManager::kDequeCapacity]) {
+}
+
+bool JobManager::Deque::push(Task *const &task) {
+  i64 bottom = bottom_.load(std::memory_order_relaxed);
+  i64 top = top_.load(std::memory_order_acquire);
+  if (bottom - top >= JobManager::kDequeCapacity) { return false; }
+  tasks_[bottom & (JobManager::kDequeCapacity - 1)].store(
+      task, std::memory_order_relaxed);
+  bottom_.store(bottom + 1, std::memory_order_release);
+  return true;
+}
+
+JobManager::Task *JobManager::Deque::pop() {
+  i64 bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  bottom_.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  i64 top = top_.load(std::memory_order_relaxed);
+  if (top > bottom) {
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  Task *task = tasks_[bottom & (JobManager::kDequeCapacity - 1)].load(
+      std::memory_order_relaxed);
+  if (top == bottom) { // last one, race the thieves for it
+    if (!top_.compare_exchange_strong(top, top + 1,
+                                      std::memory_order_seq_cst,
+                                      std::memory_order_relaxed)) {
+      task = nullptr;
+    }
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+JobManager::Task *JobManager::Deque::steal() {
+  i64 top = top_.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  i64 bottom = bottom_.load(std::memory_order_acquire);
+  if (top >= bottom) { return nullptr; }
+  Task *task = tasks_[top & (JobManager::kDequeCapacity - 1)].load(
+      std::memory_order_relaxed);
+  if (!top_.compare_exchange_strong(top, top + 1,
+                                    std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  return task;
+}
+
+void JobManager::workerLoop(usize const &worker_code) {
+  JobManager::worker_code_ = worker_code;
+  usize idle = 0;
+  while (JobManager::is_running_) {
+    Task *task = JobManager::findTask(worker_code);
+    if (task != nullptr) {
+      JobManager::execute(task);
+      idle = 0;
+      continue;
+    }
+    if (++idle < JobManager::kSpinCount) {
+      std::this_thread::yield();
+      continue;
+    }
+    // sleeping_ goes up before pending_ is read, run() reads them the
+    // other way around, so one side always sees the other
+    std::unique_lock<std::mutex> lock(JobManager::mutex_);
+    JobManager::sleeping_.fetch_add(1);
+    JobManager::condition_.wait(lock, []() {
+      return JobManager::pending_.load() > 0 || !JobManager::is_running_;
+    });
+    JobManager::sleeping_.fetch_sub(1);
+    idle = 0;
+  }
+}
+
+// own deque first, then steal around the others
+JobManager::Task *JobManager::findTask(usize const &worker_code) {
+  usize const count = JobManager::deques_.size();
+  Task *task = nullptr;
+  if (worker_code < count) {
+    task = JobManager::deques_[worker_code]->pop();
+  }
+  for (usize i = 1; task == nullptr && i <= count; ++i) {
+    usize victim = (worker_code + i) % count;
+    if (victim == worker_code) { continue; }
+    task = JobManager::deques_[victim]->steal();
+  }
+  if (task != nullptr) { JobManager::pending_.fetch_sub(1); }
+  return task;
+}
+
+// the counter drops and the task is freed even when the job throws
+void JobManager::execute(Task *const &task) {
+  std::unique_ptr<Task> owner(task);
+  struct Done {
+    JobCounter *counter_;
+    ~Done() {
+      if (counter_ != nullptr) {
+        counter_->fetch_sub(1, std::memory_order_release);
+      }
+    }
+  } done({ task->counter_ });
+  task->job_();
+}
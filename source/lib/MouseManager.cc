@@ -182,6 +182,7 @@ void MouseManager::ButtonMap::codeCheck(usize const &button_code_from,
 
 // MouseManaer
 bool MouseManager::is_entered_ = true;
+sf::Vector2i MouseManager::position_;
 MouseManager::ButtonMap const *MouseManager::button_map_ = nullptr;
 std::vector<bool> MouseManager::button_state_;
 std::vector<ButtonCallback> MouseManager::mouse_event_callbacks_(
@@ -189,12 +190,20 @@ std::vector<ButtonCallback> MouseManager::mouse_event_callbacks_(
 
 void MouseManager::eventProcess(sf::Event const &event) {
   if (event.type == sf::Event::MouseWheelScrolled) {
+    MouseManager::position_ = sf::Vector2i(event.mouseWheelScroll.x,
+                                           event.mouseWheelScroll.y);
     MouseManager::scroll(event.mouseWheelScroll);
   } else if (event.type == sf::Event::MouseButtonPressed) {
+    MouseManager::position_ = sf::Vector2i(event.mouseButton.x,
+                                           event.mouseButton.y);
     MouseManager::press(event.mouseButton);
   } else if (event.type == sf::Event::MouseButtonReleased) {
+    MouseManager::position_ = sf::Vector2i(event.mouseButton.x,
+                                           event.mouseButton.y);
     MouseManager::release(event.mouseButton);
   } else if (event.type == sf::Event::MouseMoved) {
+    MouseManager::position_ = sf::Vector2i(event.mouseMove.x,
+                                           event.mouseMove.y);
     MouseManager::move(event.mouseMove);
   } else if (event.type == sf::Event::MouseEntered) {
     MouseManager::enter(event.mouseMove);
@@ -204,24 +213,17 @@ void MouseManager::eventProcess(sf::Event const &event) {
 }
 
 void MouseManager::framework() {
-  if (MouseManager::button_map_ != nullptr) {
-    ButtonCallbackStore const &callbacks =
-        MouseManager::button_map_->getButtonCallbacks();
-    sf::Vector2i position = sf::Mouse::getPosition();
-    for (usize i = MouseManager::button_state_.size(); i--; ) {
-      if (MouseManager::button_state_[i] &&
-          callbacks[i][MouseManager::kPressed]) {
-        callbacks[i][MouseManager::kPressed](position.x, position.y);
-      }
-    }
-  }
+  MouseManager::framework(sf::Mouse::getPosition());
 }
 
 void MouseManager::framework(sf::WindowBase const &relativeTo) {
+  MouseManager::framework(sf::Mouse::getPosition(relativeTo));
+}
+
+void MouseManager::framework(sf::Vector2i const &position) {
   if (MouseManager::button_map_ != nullptr) {
     ButtonCallbackStore const &callbacks =
         MouseManager::button_map_->getButtonCallbacks();
-    sf::Vector2i position = sf::Mouse::getPosition(relativeTo);
     for (usize i = MouseManager::button_state_.size(); i--; ) {
       if (MouseManager::button_state_[i] &&
           callbacks[i][MouseManager::kPressed]) {
@@ -235,6 +237,10 @@ bool MouseManager::getIsEntered() noexcept {
   return MouseManager::is_entered_;
 }
 
+sf::Vector2i const &MouseManager::getPosition() noexcept {
+  return MouseManager::position_;
+}
+
 MouseManager::ButtonMap const *const &MouseManager::getButtonMap() noexcept {
   return MouseManager::button_map_;
 }
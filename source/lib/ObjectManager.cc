@@ -0,0 +1,211 @@
+#include <lib/ObjectManager.h>
+
+#include <stdexcept>
+#include <cmath>
+
+std::vector<sf::Vector2f> ObjectManager::positions_;
+std::vector<f32> ObjectManager::z_depths_;
+std::vector<f32> ObjectManager::rotations_;
+std::vector<sf::Vector2f> ObjectManager::scales_;
+std::vector<sf::Vector2f> ObjectManager::origins_;
+std::vector<ObjectManager::Handle> ObjectManager::handles_;
+std::vector<ObjectManager::Slot> ObjectManager::slots_;
+std::vector<u32> ObjectManager::free_slots_;
+
+ObjectManager::Handle ObjectManager::create() {
+  return ObjectManager::create(sf::Vector2f());
+}
+
+ObjectManager::Handle ObjectManager::create(sf::Vector2f const &position,
+                                            f32 const &z_depth) {
+  u32 slot;
+  if (ObjectManager::free_slots_.empty()) {
+    slot = u32(ObjectManager::slots_.size());
+    ObjectManager::slots_.push_back(Slot({ 0, 1 }));
+  } else {
+    slot = ObjectManager::free_slots_.back();
+    ObjectManager::free_slots_.pop_back();
+  }
+  Slot &entry = ObjectManager::slots_[slot];
+  entry.index = u32(ObjectManager::handles_.size());
+
+  ObjectManager::positions_.push_back(position);
+  ObjectManager::z_depths_.push_back(z_depth);
+  ObjectManager::rotations_.push_back(0.0f);
+  ObjectManager::scales_.push_back(sf::Vector2f(1.0f, 1.0f));
+  ObjectManager::origins_.push_back(sf::Vector2f());
+  ObjectManager::handles_.push_back(Handle({ slot, entry.generation }));
+  return ObjectManager::handles_.back();
+}
+
+void ObjectManager::destroy(ObjectManager::Handle const &handle) {
+  ObjectManager::handleCheck(handle);
+  Slot &entry = ObjectManager::slots_[handle.slot];
+  usize index = entry.index;
+  usize last = ObjectManager::handles_.size() - 1;
+  if (index != last) {
+    ObjectManager::positions_[index] = ObjectManager::positions_[last];
+    ObjectManager::z_depths_[index] = ObjectManager::z_depths_[last];
+    ObjectManager::rotations_[index] = ObjectManager::rotations_[last];
+    ObjectManager::scales_[index] = ObjectManager::scales_[last];
+    ObjectManager::origins_[index] = ObjectManager::origins_[last];
+    ObjectManager::handles_[index] = ObjectManager::handles_[last];
+    ObjectManager::slots_[ObjectManager::handles_[index].slot].index =
+        u32(index);
+  }
+  ObjectManager::positions_.pop_back();
+  ObjectManager::z_depths_.pop_back();
+  ObjectManager::rotations_.pop_back();
+  ObjectManager::scales_.pop_back();
+  ObjectManager::origins_.pop_back();
+  ObjectManager::handles_.pop_back();
+
+  if (++entry.generation == 0) { entry.generation = 1; }
+  ObjectManager::free_slots_.push_back(handle.slot);
+}
+
+bool ObjectManager::isAlive(ObjectManager::Handle const &handle) noexcept {
+  return (handle.slot < ObjectManager::slots_.size() &&
+          handle.generation != 0 &&
+          ObjectManager::slots_[handle.slot].generation == handle.generation);
+}
+
+void ObjectManager::clear() noexcept {
+  for (Handle const &handle : ObjectManager::handles_) {
+    Slot &entry = ObjectManager::slots_[handle.slot];
+    if (++entry.generation == 0) { entry.generation = 1; }
+    ObjectManager::free_slots_.push_back(handle.slot);
+  }
+  ObjectManager::positions_.clear();
+  ObjectManager::z_depths_.clear();
+  ObjectManager::rotations_.clear();
+  ObjectManager::scales_.clear();
+  ObjectManager::origins_.clear();
+  ObjectManager::handles_.clear();
+}
+
+void ObjectManager::reserve(usize const &capacity) {
+  ObjectManager::positions_.reserve(capacity);
+  ObjectManager::z_depths_.reserve(capacity);
+  ObjectManager::rotations_.reserve(capacity);
+  ObjectManager::scales_.reserve(capacity);
+  ObjectManager::origins_.reserve(capacity);
+  ObjectManager::handles_.reserve(capacity);
+  ObjectManager::slots_.reserve(capacity);
+}
+
+usize ObjectManager::getObjectCount() noexcept {
+  return ObjectManager::handles_.size();
+}
+
+usize ObjectManager::getIndex(ObjectManager::Handle const &handle) {
+  ObjectManager::handleCheck(handle);
+  return ObjectManager::slots_[handle.slot].index;
+}
+
+ObjectManager::Handle const &ObjectManager::getHandle(usize const &index) {
+  if (index >= ObjectManager::handles_.size()) {
+    throw std::runtime_error("No exist object index.");
+  }
+  return ObjectManager::handles_[index];
+}
+
+std::vector<sf::Vector2f> &ObjectManager::getPositions() noexcept {
+  return ObjectManager::positions_;
+}
+
+std::vector<f32> &ObjectManager::getZDepths() noexcept {
+  return ObjectManager::z_depths_;
+}
+
+std::vector<f32> &ObjectManager::getRotations() noexcept {
+  return ObjectManager::rotations_;
+}
+
+std::vector<sf::Vector2f> &ObjectManager::getScales() noexcept {
+  return ObjectManager::scales_;
+}
+
+std::vector<sf::Vector2f> &ObjectManager::getOrigins() noexcept {
+  return ObjectManager::origins_;
+}
+
+sf::Vector2f const &ObjectManager::getPosition(
+    ObjectManager::Handle const &handle) {
+  return ObjectManager::positions_[ObjectManager::getIndex(handle)];
+}
+
+f32 const &ObjectManager::getZDepth(ObjectManager::Handle const &handle) {
+  return ObjectManager::z_depths_[ObjectManager::getIndex(handle)];
+}
+
+f32 const &ObjectManager::getRotation(ObjectManager::Handle const &handle) {
+  return ObjectManager::rotations_[ObjectManager::getIndex(handle)];
+}
+
+sf::Vector2f const &ObjectManager::getScale(
+    ObjectManager::Handle const &handle) {
+  return ObjectManager::scales_[ObjectManager::getIndex(handle)];
+}
+
+sf::Vector2f const &ObjectManager::getOrigin(
+    ObjectManager::Handle const &handle) {
+  return ObjectManager::origins_[ObjectManager::getIndex(handle)];
+}
+
+void ObjectManager::setPosition(ObjectManager::Handle const &handle,
+                                sf::Vector2f const &position) {
+  ObjectManager::positions_[ObjectManager::getIndex(handle)] = position;
+}
+
+void ObjectManager::setZDepth(ObjectManager::Handle const &handle,
+                              f32 const &z_depth) {
+  ObjectManager::z_depths_[ObjectManager::getIndex(handle)] = z_depth;
+}
+
+void ObjectManager::setRotation(ObjectManager::Handle const &handle,
+                                f32 const &angle) {
+  ObjectManager::rotations_[ObjectManager::getIndex(handle)] = angle;
+}
+
+void ObjectManager::setScale(ObjectManager::Handle const &handle,
+                             sf::Vector2f const &factor) {
+  ObjectManager::scales_[ObjectManager::getIndex(handle)] = factor;
+}
+
+void ObjectManager::setOrigin(ObjectManager::Handle const &handle,
+                              sf::Vector2f const &origin) {
+  ObjectManager::origins_[ObjectManager::getIndex(handle)] = origin;
+}
+
+// same composition as sf::Transformable::getTransform
+sf::Transform ObjectManager::getTransform(usize const &index) {
+  if (index >= ObjectManager::handles_.size()) {
+    throw std::runtime_error("No exist object index.");
+  }
+  sf::Vector2f const &position = ObjectManager::positions_[index];
+  sf::Vector2f const &scale = ObjectManager::scales_[index];
+  sf::Vector2f const &origin = ObjectManager::origins_[index];
+  f32 angle = -ObjectManager::rotations_[index] * 3.141592654f / 180.0f;
+  f32 cosine = std::cos(angle);
+  f32 sine = std::sin(angle);
+  f32 sxc = scale.x * cosine;
+  f32 syc = scale.y * cosine;
+  f32 sxs = scale.x * sine;
+  f32 sys = scale.y * sine;
+  f32 tx = -origin.x * sxc - origin.y * sys + position.x;
+  f32 ty = origin.x * sxs - origin.y * syc + position.y;
+  return sf::Transform(sxc, sys, tx,
+                       -sxs, syc, ty,
+                       0.0f, 0.0f, 1.0f);
+}
+
+sf::Transform ObjectManager::getTransform(ObjectManager::Handle const &handle) {
+  return ObjectManager::getTransform(ObjectManager::getIndex(handle));
+}
+
+void ObjectManager::handleCheck(ObjectManager::Handle const &handle) {
+  if (!ObjectManager::isAlive(handle)) {
+    throw std::runtime_error("No exist object handle.");
+  }
+}
@@ -0,0 +1,508 @@
+#include <lib/PhysicsManager.h>
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include <lib/JobManager.h>
+
+static constexpr f32 kEpsilon = 0.01f;
+
+f32 PhysicsManager::gravity_ = 2000.0f;
+f32 PhysicsManager::terminal_velocity_ = 1200.0f;
+
+std::vector<PhysicsManager::Foothold> PhysicsManager::footholds_;
+std::vector<PhysicsManager::Ladder> PhysicsManager::ladders_;
+std::unordered_map<i32, std::vector<usize>> PhysicsManager::columns_;
+
+std::vector<ObjectManager::Handle> PhysicsManager::body_handles_;
+std::vector<sf::Vector2f> PhysicsManager::body_sizes_;
+std::vector<sf::Vector2f> PhysicsManager::body_velocities_;
+std::vector<u8> PhysicsManager::body_states_;
+std::vector<usize> PhysicsManager::body_supports_;
+std::vector<usize> PhysicsManager::body_codes_;
+std::vector<usize> PhysicsManager::body_slots_;
+std::vector<usize> PhysicsManager::free_body_codes_;
+
+void PhysicsManager::initialize() {
+  PhysicsManager::release();
+}
+
+void PhysicsManager::release() {
+  PhysicsManager::clearTerrain();
+  PhysicsManager::body_handles_.clear();
+  PhysicsManager::body_sizes_.clear();
+  PhysicsManager::body_velocities_.clear();
+  PhysicsManager::body_states_.clear();
+  PhysicsManager::body_supports_.clear();
+  PhysicsManager::body_codes_.clear();
+  PhysicsManager::body_slots_.clear();
+  PhysicsManager::free_body_codes_.clear();
+}
+
+f32 const &PhysicsManager::getGravity() noexcept {
+  return PhysicsManager::gravity_;
+}
+
+void PhysicsManager::setGravity(f32 const &gravity) noexcept {
+  PhysicsManager::gravity_ = gravity;
+}
+
+f32 const &PhysicsManager::getTerminalVelocity() noexcept {
+  return PhysicsManager::terminal_velocity_;
+}
+
+void PhysicsManager::setTerminalVelocity(
+    f32 const &terminal_velocity) noexcept {
+  PhysicsManager::terminal_velocity_ = terminal_velocity;
+}
+
+usize PhysicsManager::addFoothold(sf::Vector2f const &from,
+                                  sf::Vector2f const &to) {
+  if (from == to) {
+    throw std::runtime_error("foothold must have a length.");
+  }
+  Foothold foothold({ from, to, usize(-1), usize(-1), from.x == to.x });
+  if (foothold.is_wall ? from.y > to.y : from.x > to.x) {
+    std::swap(foothold.from, foothold.to);
+  }
+  usize const foothold_code = PhysicsManager::footholds_.size();
+  auto touches = [](sf::Vector2f const &a, sf::Vector2f const &b) {
+    return std::abs(a.x - b.x) < 0.5f && std::abs(a.y - b.y) < 0.5f;
+  };
+  // a wall only joins the chain at its bottom end, where it blocks, and
+  // wins over a floor continuing from the same point
+  auto link = [](usize &end, usize const &code, bool const &is_wall) {
+    if (end == usize(-1) || is_wall) { end = code; }
+  };
+  for (usize i = 0; i < foothold_code; ++i) {
+    Foothold &other = PhysicsManager::footholds_[i];
+    if (foothold.is_wall && other.is_wall) { continue; }
+    if (foothold.is_wall) {
+      if (touches(other.to, foothold.to)) {
+        link(other.next, foothold_code, true);
+      }
+      if (touches(other.from, foothold.to)) {
+        link(other.prev, foothold_code, true);
+      }
+    } else if (other.is_wall) {
+      if (touches(foothold.to, other.to)) { link(foothold.next, i, true); }
+      if (touches(foothold.from, other.to)) { link(foothold.prev, i, true); }
+    } else {
+      if (touches(other.to, foothold.from)) {
+        link(other.next, foothold_code, false);
+        link(foothold.prev, i, false);
+      }
+      if (touches(foothold.to, other.from)) {
+        link(foothold.next, i, false);
+        link(other.prev, foothold_code, false);
+      }
+    }
+  }
+  PhysicsManager::footholds_.push_back(foothold);
+  i32 first = PhysicsManager::getColumn(foothold.from.x);
+  i32 last = PhysicsManager::getColumn(foothold.to.x);
+  for (i32 column = first; column <= last; ++column) {
+    PhysicsManager::columns_[column].push_back(foothold_code);
+  }
+  return foothold_code;
+}
+
+usize PhysicsManager::addLadder(f32 const &x,
+                                f32 const &top,
+                                f32 const &bottom) {
+  if (!(top < bottom)) {
+    throw std::runtime_error("ladder top must be above its bottom.");
+  }
+  PhysicsManager::ladders_.push_back(Ladder({ x, top, bottom }));
+  return PhysicsManager::ladders_.size() - 1;
+}
+
+// bodies standing on or climbing the old terrain fall from where they are
+void PhysicsManager::clearTerrain() {
+  PhysicsManager::footholds_.clear();
+  PhysicsManager::ladders_.clear();
+  PhysicsManager::columns_.clear();
+  for (usize i = 0; i < PhysicsManager::body_states_.size(); ++i) {
+    PhysicsManager::body_states_[i] = kAir;
+    PhysicsManager::body_supports_[i] = usize(-1);
+  }
+}
+
+usize PhysicsManager::getFootholdCount() noexcept {
+  return PhysicsManager::footholds_.size();
+}
+
+PhysicsManager::Foothold const &PhysicsManager::getFoothold(
+    usize const &foothold_code) {
+  if (foothold_code >= PhysicsManager::footholds_.size()) {
+    throw std::runtime_error("No exist foothold_code.");
+  }
+  return PhysicsManager::footholds_[foothold_code];
+}
+
+usize PhysicsManager::getLadderCount() noexcept {
+  return PhysicsManager::ladders_.size();
+}
+
+PhysicsManager::Ladder const &PhysicsManager::getLadder(
+    usize const &ladder_code) {
+  if (ladder_code >= PhysicsManager::ladders_.size()) {
+    throw std::runtime_error("No exist ladder_code.");
+  }
+  return PhysicsManager::ladders_[ladder_code];
+}
+
+usize PhysicsManager::createBody(ObjectManager::Handle const &handle,
+                                 sf::Vector2f const &size) {
+  usize body_code;
+  if (PhysicsManager::free_body_codes_.empty()) {
+    body_code = PhysicsManager::body_slots_.size();
+    PhysicsManager::body_slots_.push_back(usize(-1));
+  } else {
+    body_code = PhysicsManager::free_body_codes_.back();
+    PhysicsManager::free_body_codes_.pop_back();
+  }
+  PhysicsManager::body_slots_[body_code] =
+      PhysicsManager::body_handles_.size();
+  PhysicsManager::body_handles_.push_back(handle);
+  PhysicsManager::body_sizes_.push_back(size);
+  PhysicsManager::body_velocities_.push_back(sf::Vector2f());
+  PhysicsManager::body_states_.push_back(kAir);
+  PhysicsManager::body_supports_.push_back(usize(-1));
+  PhysicsManager::body_codes_.push_back(body_code);
+  return body_code;
+}
+
+void PhysicsManager::destroyBody(usize const &body_code) {
+  PhysicsManager::codeCheck(body_code);
+  usize index = PhysicsManager::body_slots_[body_code];
+  usize last = PhysicsManager::body_codes_.size() - 1;
+  if (index != last) {
+    PhysicsManager::body_handles_[index] = PhysicsManager::body_handles_[last];
+    PhysicsManager::body_sizes_[index] = PhysicsManager::body_sizes_[last];
+    PhysicsManager::body_velocities_[index] =
+        PhysicsManager::body_velocities_[last];
+    PhysicsManager::body_states_[index] = PhysicsManager::body_states_[last];
+    PhysicsManager::body_supports_[index] =
+        PhysicsManager::body_supports_[last];
+    PhysicsManager::body_codes_[index] = PhysicsManager::body_codes_[last];
+    PhysicsManager::body_slots_[PhysicsManager::body_codes_[index]] = index;
+  }
+  PhysicsManager::body_handles_.pop_back();
+  PhysicsManager::body_sizes_.pop_back();
+  PhysicsManager::body_velocities_.pop_back();
+  PhysicsManager::body_states_.pop_back();
+  PhysicsManager::body_supports_.pop_back();
+  PhysicsManager::body_codes_.pop_back();
+  PhysicsManager::body_slots_[body_code] = usize(-1);
+  PhysicsManager::free_body_codes_.push_back(body_code);
+}
+
+bool PhysicsManager::isAlive(usize const &body_code) noexcept {
+  return (body_code < PhysicsManager::body_slots_.size() &&
+          PhysicsManager::body_slots_[body_code] != usize(-1));
+}
+
+usize PhysicsManager::getBodyCount() noexcept {
+  return PhysicsManager::body_codes_.size();
+}
+
+void PhysicsManager::reserve(usize const &body_count) {
+  PhysicsManager::body_handles_.reserve(body_count);
+  PhysicsManager::body_sizes_.reserve(body_count);
+  PhysicsManager::body_velocities_.reserve(body_count);
+  PhysicsManager::body_states_.reserve(body_count);
+  PhysicsManager::body_supports_.reserve(body_count);
+  PhysicsManager::body_codes_.reserve(body_count);
+  PhysicsManager::body_slots_.reserve(body_count);
+}
+
+ObjectManager::Handle const &PhysicsManager::getHandle(
+    usize const &body_code) {
+  PhysicsManager::codeCheck(body_code);
+  return PhysicsManager::body_handles_[PhysicsManager::body_slots_[body_code]];
+}
+
+sf::Vector2f const &PhysicsManager::getSize(usize const &body_code) {
+  PhysicsManager::codeCheck(body_code);
+  return PhysicsManager::body_sizes_[PhysicsManager::body_slots_[body_code]];
+}
+
+void PhysicsManager::setSize(usize const &body_code,
+                             sf::Vector2f const &size) {
+  PhysicsManager::codeCheck(body_code);
+  PhysicsManager::body_sizes_[PhysicsManager::body_slots_[body_code]] = size;
+}
+
+sf::Vector2f const &PhysicsManager::getVelocity(usize const &body_code) {
+  PhysicsManager::codeCheck(body_code);
+  return PhysicsManager::body_velocities_[
+      PhysicsManager::body_slots_[body_code]];
+}
+
+void PhysicsManager::setVelocity(usize const &body_code,
+                                 sf::Vector2f const &velocity) {
+  PhysicsManager::codeCheck(body_code);
+  PhysicsManager::body_velocities_[PhysicsManager::body_slots_[body_code]] =
+      velocity;
+}
+
+PhysicsManager::BodyState PhysicsManager::getState(usize const &body_code) {
+  PhysicsManager::codeCheck(body_code);
+  return BodyState(
+      PhysicsManager::body_states_[PhysicsManager::body_slots_[body_code]]);
+}
+
+usize PhysicsManager::getStandingFoothold(usize const &body_code) {
+  PhysicsManager::codeCheck(body_code);
+  usize index = PhysicsManager::body_slots_[body_code];
+  if (PhysicsManager::body_states_[index] != kGround) { return usize(-1); }
+  return PhysicsManager::body_supports_[index];
+}
+
+void PhysicsManager::walk(usize const &body_code, f32 const &speed) {
+  PhysicsManager::codeCheck(body_code);
+  usize index = PhysicsManager::body_slots_[body_code];
+  if (PhysicsManager::body_states_[index] == kLadder) { return; }
+  PhysicsManager::body_velocities_[index].x = speed;
+}
+
+bool PhysicsManager::jump(usize const &body_code, f32 const &speed) {
+  PhysicsManager::codeCheck(body_code);
+  usize index = PhysicsManager::body_slots_[body_code];
+  if (PhysicsManager::body_states_[index] == kAir) { return false; }
+  PhysicsManager::body_velocities_[index].y = -speed;
+  PhysicsManager::body_states_[index] = kAir;
+  PhysicsManager::body_supports_[index] = usize(-1);
+  return true;
+}
+
+bool PhysicsManager::grabLadder(usize const &body_code) {
+  PhysicsManager::codeCheck(body_code);
+  usize index = PhysicsManager::body_slots_[body_code];
+  sf::Vector2f position = ObjectManager::getPosition(
+      PhysicsManager::body_handles_[index]);
+  sf::Vector2f const &size = PhysicsManager::body_sizes_[index];
+  for (usize i = 0; i < PhysicsManager::ladders_.size(); ++i) {
+    Ladder const &ladder = PhysicsManager::ladders_[i];
+    if (std::abs(position.x - ladder.x) > size.x / 2.0f ||
+        position.y < ladder.top || position.y - size.y > ladder.bottom) {
+      continue;
+    }
+    position.x = ladder.x;
+    position.y = std::min(position.y, ladder.bottom);
+    ObjectManager::setPosition(PhysicsManager::body_handles_[index], position);
+    PhysicsManager::body_velocities_[index] = sf::Vector2f();
+    PhysicsManager::body_states_[index] = kLadder;
+    PhysicsManager::body_supports_[index] = i;
+    return true;
+  }
+  return false;
+}
+
+void PhysicsManager::climb(usize const &body_code, f32 const &speed) {
+  PhysicsManager::codeCheck(body_code);
+  usize index = PhysicsManager::body_slots_[body_code];
+  if (PhysicsManager::body_states_[index] != kLadder) { return; }
+  PhysicsManager::body_velocities_[index].y = speed;
+}
+
+// bodies only touch their own slot and position, chunks run on the jobs
+void PhysicsManager::step(sf::Time const &dt) {
+  f32 seconds = dt.asSeconds();
+  std::vector<sf::Vector2f> &positions = ObjectManager::getPositions();
+  JobManager::parallelFor(0, PhysicsManager::body_codes_.size(),
+                          kStepGrain, [&](usize const &begin,
+                                          usize const &end) {
+    for (usize i = begin; i < end; ++i) {
+      sf::Vector2f &position = positions[
+          ObjectManager::getIndex(PhysicsManager::body_handles_[i])];
+      switch (PhysicsManager::body_states_[i]) {
+       case kGround:
+        PhysicsManager::stepGround(i, position, seconds);
+        break;
+       case kLadder:
+        PhysicsManager::stepLadder(i, position, seconds);
+        break;
+       default:
+        PhysicsManager::stepAir(i, position, seconds);
+        break;
+      }
+    }
+  });
+}
+
+void PhysicsManager::codeCheck(usize const &body_code) {
+  if (!PhysicsManager::isAlive(body_code)) {
+    throw std::runtime_error("No exist body_code.");
+  }
+}
+
+i32 PhysicsManager::getColumn(f32 const &x) noexcept {
+  return i32(std::floor(x / kColumnWidth));
+}
+
+f32 PhysicsManager::getHeight(Foothold const &foothold,
+                              f32 const &x) noexcept {
+  f32 const dx = foothold.to.x - foothold.from.x;
+  return (foothold.from.y +
+          (foothold.to.y - foothold.from.y) * (x - foothold.from.x) / dx);
+}
+
+// how far the box gets along dx before a wall, dy tilts the box meanwhile
+f32 PhysicsManager::sweepWalls(sf::FloatRect const &box,
+                               f32 const &dx,
+                               f32 const &dy) {
+  if (dx == 0.0f) { return 0.0f; }
+  f32 const left = box.left;
+  f32 const right = box.left + box.width;
+  f32 reach = dx;
+  i32 first = PhysicsManager::getColumn(left + std::min(dx, 0.0f));
+  i32 last = PhysicsManager::getColumn(right + std::max(dx, 0.0f));
+  for (i32 column = first; column <= last; ++column) {
+    auto found = PhysicsManager::columns_.find(column);
+    if (found == PhysicsManager::columns_.end()) { continue; }
+    for (usize const &foothold_code : found->second) {
+      Foothold const &wall = PhysicsManager::footholds_[foothold_code];
+      if (!wall.is_wall) { continue; }
+      f32 distance;
+      if (dx > 0.0f) {
+        if (right > wall.from.x + kEpsilon) { continue; } // already past
+        distance = wall.from.x - right;
+        if (distance >= reach) { continue; }
+      } else {
+        if (left < wall.from.x - kEpsilon) { continue; }
+        distance = wall.from.x - left;
+        if (distance <= reach) { continue; }
+      }
+      f32 top = box.top + dy * (distance / dx);
+      if (top + box.height <= wall.from.y || top >= wall.to.y) { continue; }
+      reach = distance;
+    }
+  }
+  return reach;
+}
+
+// first floor the feet cross from above, one way so jumps pass through
+usize PhysicsManager::sweepFloors(sf::Vector2f const &feet,
+                                  sf::Vector2f const &displacement,
+                                  f32 &t) {
+  usize hit = usize(-1);
+  t = 1.0f;
+  f32 const end_x = feet.x + displacement.x;
+  f32 const end_y = feet.y + displacement.y;
+  f32 const min_x = std::min(feet.x, end_x);
+  f32 const max_x = std::max(feet.x, end_x);
+  i32 first = PhysicsManager::getColumn(min_x);
+  i32 last = PhysicsManager::getColumn(max_x);
+  for (i32 column = first; column <= last; ++column) {
+    auto found = PhysicsManager::columns_.find(column);
+    if (found == PhysicsManager::columns_.end()) { continue; }
+    for (usize const &foothold_code : found->second) {
+      Foothold const &floor = PhysicsManager::footholds_[foothold_code];
+      if (floor.is_wall || floor.to.x < min_x || floor.from.x > max_x) {
+        continue;
+      }
+      f32 side_from = feet.y - PhysicsManager::getHeight(floor, feet.x);
+      f32 side_to = end_y - PhysicsManager::getHeight(floor, end_x);
+      if (side_from > kEpsilon || side_to <= 0.0f) { continue; }
+      f32 crossing = side_from >= 0.0f ? 0.0f :
+                     side_from / (side_from - side_to);
+      f32 x = feet.x + displacement.x * crossing;
+      if (x < floor.from.x || x > floor.to.x || crossing >= t) { continue; }
+      t = crossing;
+      hit = foothold_code;
+    }
+  }
+  return hit;
+}
+
+// follows the foothold chain, leaving its end drops into the air
+void PhysicsManager::stepGround(usize const &index,
+                                sf::Vector2f &position,
+                                f32 dt) {
+  sf::Vector2f &velocity = PhysicsManager::body_velocities_[index];
+  sf::Vector2f const &size = PhysicsManager::body_sizes_[index];
+  usize &support = PhysicsManager::body_supports_[index];
+  f32 dx = velocity.x * dt;
+  if (dx != 0.0f) {
+    sf::FloatRect box(position.x - size.x / 2.0f, position.y - size.y,
+                      size.x, size.y - kEpsilon); // feet may touch walls
+    f32 reach = PhysicsManager::sweepWalls(box, dx, 0.0f);
+    if (reach != dx) { velocity.x = 0.0f; }
+    dx = reach;
+  }
+  f32 x = position.x + dx;
+  while (true) {
+    Foothold const &floor = PhysicsManager::footholds_[support];
+    bool is_past_to = x > floor.to.x;
+    bool is_past_from = x < floor.from.x;
+    if (!is_past_to && !is_past_from) { break; }
+    usize next = is_past_to ? floor.next : floor.prev;
+    f32 edge = is_past_to ? floor.to.x : floor.from.x;
+    if (next == usize(-1)) {
+      position = sf::Vector2f(x, PhysicsManager::getHeight(floor, edge));
+      PhysicsManager::body_states_[index] = kAir;
+      support = usize(-1);
+      return;
+    }
+    if (PhysicsManager::footholds_[next].is_wall) {
+      x = edge;
+      velocity.x = 0.0f;
+      break;
+    }
+    support = next;
+  }
+  position.x = x;
+  position.y = PhysicsManager::getHeight(
+      PhysicsManager::footholds_[support], x);
+}
+
+// leaving either end lets go, off the top the feet land on the floor there
+void PhysicsManager::stepLadder(usize const &index,
+                                sf::Vector2f &position,
+                                f32 dt) {
+  sf::Vector2f &velocity = PhysicsManager::body_velocities_[index];
+  Ladder const &ladder =
+      PhysicsManager::ladders_[PhysicsManager::body_supports_[index]];
+  position.x = ladder.x;
+  position.y += velocity.y * dt;
+  if (position.y >= ladder.top && position.y <= ladder.bottom) { return; }
+  position.y = std::min(std::max(position.y, ladder.top), ladder.bottom);
+  velocity = sf::Vector2f();
+  PhysicsManager::body_states_[index] = kAir;
+  PhysicsManager::body_supports_[index] = usize(-1);
+}
+
+void PhysicsManager::stepAir(usize const &index,
+                             sf::Vector2f &position,
+                             f32 dt) {
+  sf::Vector2f &velocity = PhysicsManager::body_velocities_[index];
+  sf::Vector2f const &size = PhysicsManager::body_sizes_[index];
+  velocity.y = std::min(velocity.y + PhysicsManager::gravity_ * dt,
+                        PhysicsManager::terminal_velocity_);
+  sf::Vector2f displacement = velocity * dt;
+  if (displacement.x != 0.0f) {
+    sf::FloatRect box(position.x - size.x / 2.0f, position.y - size.y,
+                      size.x, size.y);
+    f32 reach = PhysicsManager::sweepWalls(box, displacement.x,
+                                           displacement.y);
+    if (reach != displacement.x) {
+      displacement.x = reach;
+      velocity.x = 0.0f;
+    }
+  }
+  f32 t;
+  usize hit = PhysicsManager::sweepFloors(position, displacement, t);
+  if (hit == usize(-1)) {
+    position += displacement;
+    return;
+  }
+  Foothold const &floor = PhysicsManager::footholds_[hit];
+  position.x += displacement.x * t;
+  position.y = PhysicsManager::getHeight(floor, position.x);
+  velocity.y = 0.0f;
+  PhysicsManager::body_states_[index] = kGround;
+  PhysicsManager::body_supports_[index] = hit;
+}
@@ -0,0 +1,309 @@
+#include <lib/RectPacker.h>
+
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+
+RectPacker::RectPacker()
+    : ownership(new RectPacker::Inner()) {
+}
+
+RectPacker::RectPacker(usize const &width,
+                       usize const &height,
+                       RectPacker::Method const &method,
+                       bool const &allow_rotation)
+    : ownership(new RectPacker::Inner()) {
+  this->setMethod(method);
+  ownership->allow_rotation_ = allow_rotation;
+  this->create(width, height);
+}
+
+RectPacker::RectPacker(RectPacker const &rhs) noexcept
+    : ownership() {
+  *this = rhs;
+}
+
+RectPacker &RectPacker::operator=(RectPacker const &rhs) noexcept {
+  if (this == &rhs) { return *this; }
+  if (ownership != nullptr) { delete ownership; }
+  ownership = rhs.ownership;
+  const_cast<RectPacker &>(rhs).ownership = nullptr;
+  return *this;
+}
+
+RectPacker::~RectPacker() noexcept {
+  if (ownership != nullptr) { delete ownership; }
+}
+
+RectPacker RectPacker::clone() const {
+  this->ownershipCheck();
+  return RectPacker(new RectPacker::Inner(*ownership));
+}
+
+void RectPacker::create(usize const &width, usize const &height) {
+  this->ownershipCheck();
+  ownership->width_ = i32(width);
+  ownership->height_ = i32(height);
+  ownership->used_area_ = 0;
+  ownership->used_size_ = sf::Vector2u();
+  ownership->free_rects_.assign(
+      1, sf::IntRect(0, 0, ownership->width_, ownership->height_));
+  ownership->skyline_.assign(1, SkylineNode({ 0, 0, ownership->width_ }));
+}
+
+sf::Vector2u RectPacker::getSize() const {
+  this->ownershipCheck();
+  return sf::Vector2u(ownership->width_, ownership->height_);
+}
+
+sf::Vector2u RectPacker::getUsedSize() const {
+  this->ownershipCheck();
+  return ownership->used_size_;
+}
+
+usize RectPacker::getUsedArea() const {
+  this->ownershipCheck();
+  return ownership->used_area_;
+}
+
+RectPacker::Method const &RectPacker::getMethod() const {
+  this->ownershipCheck();
+  return ownership->method_;
+}
+
+void RectPacker::setMethod(RectPacker::Method const &method) {
+  this->ownershipCheck();
+  if (method >= RectPacker::kMethodCount) {
+    throw std::runtime_error("No exist method.");
+  }
+  ownership->method_ = method;
+}
+
+bool const &RectPacker::getAllowRotation() const {
+  this->ownershipCheck();
+  return ownership->allow_rotation_;
+}
+
+void RectPacker::setAllowRotation(bool const &allow_rotation) {
+  this->ownershipCheck();
+  ownership->allow_rotation_ = allow_rotation;
+}
+
+bool RectPacker::insert(usize const &width,
+                        usize const &height,
+                        RectPacker::Placement &placement) {
+  this->ownershipCheck();
+  if (width == 0 || height == 0) {
+    placement = Placement({ sf::IntRect(0, 0, i32(width), i32(height)), false });
+    return true;
+  }
+  if (ownership->method_ == RectPacker::kMaxRects) {
+    if (!this->findMaxRects(i32(width), i32(height), placement)) {
+      return false;
+    }
+    this->placeMaxRects(placement.rect);
+  } else {
+    usize node_code;
+    if (!this->findSkyline(i32(width), i32(height), placement, node_code)) {
+      return false;
+    }
+    this->placeSkyline(placement.rect, node_code);
+  }
+  sf::IntRect const &rect = placement.rect;
+  ownership->used_area_ += usize(rect.width) * usize(rect.height);
+  ownership->used_size_.x = std::max(ownership->used_size_.x,
+                                     u32(rect.left + rect.width));
+  ownership->used_size_.y = std::max(ownership->used_size_.y,
+                                     u32(rect.top + rect.height));
+  return true;
+}
+
+RectPacker::Inner::Inner()
+    : width_(),
+      height_(),
+      method_(RectPacker::kMaxRects),
+      allow_rotation_(),
+      used_area_(),
+      used_size_() {
+}
+
+RectPacker::Inner::Inner(RectPacker::Inner const &rhs) {
+  *this = rhs;
+}
+
+RectPacker::Inner &RectPacker::Inner::operator=(RectPacker::Inner const &rhs) {
+  if (this == &rhs) { return *this; }
+  this->width_ = rhs.width_;
+  this->height_ = rhs.height_;
+  this->method_ = rhs.method_;
+  this->allow_rotation_ = rhs.allow_rotation_;
+  this->used_area_ = rhs.used_area_;
+  this->used_size_ = rhs.used_size_;
+  this->free_rects_.assign(rhs.free_rects_.begin(), rhs.free_rects_.end());
+  this->skyline_.assign(rhs.skyline_.begin(), rhs.skyline_.end());
+  return *this;
+}
+
+RectPacker::RectPacker(RectPacker::Inner *const &ownership) noexcept
+    : ownership(ownership) {
+}
+
+void RectPacker::ownershipCheck() const {
+  if (ownership == nullptr) {
+    throw std::runtime_error("No ownership rights whatsoever: RectPacker");
+  }
+}
+
+// best short side fit
+bool RectPacker::findMaxRects(i32 const &width,
+                              i32 const &height,
+                              RectPacker::Placement &placement) const {
+  i32 best_short = std::numeric_limits<i32>::max();
+  i32 best_long = std::numeric_limits<i32>::max();
+  auto score = [&](sf::IntRect const &free_rect,
+                   i32 const &w, i32 const &h, bool const &is_rotated) {
+    if (w > free_rect.width || h > free_rect.height) { return; }
+    i32 remain_x = free_rect.width - w;
+    i32 remain_y = free_rect.height - h;
+    i32 short_side = std::min(remain_x, remain_y);
+    i32 long_side = std::max(remain_x, remain_y);
+    if (short_side < best_short ||
+        (short_side == best_short && long_side < best_long)) {
+      best_short = short_side;
+      best_long = long_side;
+      placement.rect = sf::IntRect(free_rect.left, free_rect.top, w, h);
+      placement.is_rotated = is_rotated;
+    }
+  };
+  for (sf::IntRect const &free_rect : ownership->free_rects_) {
+    score(free_rect, width, height, false);
+    if (ownership->allow_rotation_ && width != height) {
+      score(free_rect, height, width, true);
+    }
+  }
+  return best_short != std::numeric_limits<i32>::max();
+}
+
+void RectPacker::placeMaxRects(sf::IntRect const &rect) {
+  std::vector<sf::IntRect> &free_rects = ownership->free_rects_;
+  for (usize i = free_rects.size(); i--; ) {
+    sf::IntRect const free_rect = free_rects[i];
+    if (!free_rect.intersects(rect)) { continue; }
+    free_rects[i] = free_rects.back();
+    free_rects.pop_back();
+    i32 free_right = free_rect.left + free_rect.width;
+    i32 free_bottom = free_rect.top + free_rect.height;
+    i32 rect_right = rect.left + rect.width;
+    i32 rect_bottom = rect.top + rect.height;
+    if (rect.left > free_rect.left) {
+      free_rects.push_back(sf::IntRect(free_rect.left, free_rect.top,
+                                       rect.left - free_rect.left,
+                                       free_rect.height));
+    }
+    if (rect_right < free_right) {
+      free_rects.push_back(sf::IntRect(rect_right, free_rect.top,
+                                       free_right - rect_right,
+                                       free_rect.height));
+    }
+    if (rect.top > free_rect.top) {
+      free_rects.push_back(sf::IntRect(free_rect.left, free_rect.top,
+                                       free_rect.width,
+                                       rect.top - free_rect.top));
+    }
+    if (rect_bottom < free_bottom) {
+      free_rects.push_back(sf::IntRect(free_rect.left, rect_bottom,
+                                       free_rect.width,
+                                       free_bottom - rect_bottom));
+    }
+  }
+  auto contains = [](sf::IntRect const &outer, sf::IntRect const &inner) {
+    return inner.left >= outer.left && inner.top >= outer.top &&
+           inner.left + inner.width <= outer.left + outer.width &&
+           inner.top + inner.height <= outer.top + outer.height;
+  };
+  for (usize i = 0; i < free_rects.size(); ++i) {
+    for (usize j = i + 1; j < free_rects.size(); ) {
+      if (contains(free_rects[j], free_rects[i])) {
+        free_rects.erase(free_rects.begin() + i);
+        --i;
+        break;
+      }
+      if (contains(free_rects[i], free_rects[j])) {
+        free_rects.erase(free_rects.begin() + j);
+      } else {
+        ++j;
+      }
+    }
+  }
+}
+
+// bottom left
+bool RectPacker::findSkyline(i32 const &width,
+                             i32 const &height,
+                             RectPacker::Placement &placement,
+                             usize &node_code) const {
+  i32 best_bottom = std::numeric_limits<i32>::max();
+  i32 best_width = std::numeric_limits<i32>::max();
+  auto score = [&](usize const &i,
+                   i32 const &w, i32 const &h, bool const &is_rotated) {
+    i32 y = this->fitSkyline(i, w, h);
+    if (y < 0) { return; }
+    SkylineNode const &node = ownership->skyline_[i];
+    if (y + h < best_bottom ||
+        (y + h == best_bottom && node.width < best_width)) {
+      best_bottom = y + h;
+      best_width = node.width;
+      placement.rect = sf::IntRect(node.x, y, w, h);
+      placement.is_rotated = is_rotated;
+      node_code = i;
+    }
+  };
+  for (usize i = 0; i < ownership->skyline_.size(); ++i) {
+    score(i, width, height, false);
+    if (ownership->allow_rotation_ && width != height) {
+      score(i, height, width, true);
+    }
+  }
+  return best_bottom != std::numeric_limits<i32>::max();
+}
+
+void RectPacker::placeSkyline(sf::IntRect const &rect,
+                              usize const &node_code) {
+  std::vector<SkylineNode> &skyline = ownership->skyline_;
+  skyline.insert(skyline.begin() + node_code,
+                 SkylineNode({ rect.left, rect.top + rect.height, rect.width }));
+  for (usize i = node_code + 1; i < skyline.size(); ) {
+    SkylineNode const &prev = skyline[i - 1];
+    i32 shrink = prev.x + prev.width - skyline[i].x;
+    if (shrink <= 0) { break; }
+    skyline[i].x += shrink;
+    skyline[i].width -= shrink;
+    if (skyline[i].width > 0) { break; }
+    skyline.erase(skyline.begin() + i);
+  }
+  for (usize i = 0; i + 1 < skyline.size(); ) {
+    if (skyline[i].y == skyline[i + 1].y) {
+      skyline[i].width += skyline[i + 1].width;
+      skyline.erase(skyline.begin() + i + 1);
+    } else {
+      ++i;
+    }
+  }
+}
+
+i32 RectPacker::fitSkyline(usize const &node_code,
+                           i32 const &width,
+                           i32 const &height) const {
+  std::vector<SkylineNode> const &skyline = ownership->skyline_;
+  i32 x = skyline[node_code].x;
+  if (x + width > ownership->width_) { return -1; }
+  i32 y = 0;
+  i32 remain = width;
+  for (usize i = node_code; remain > 0; ++i) {
+    if (i == skyline.size()) { return -1; }
+    y = std::max(y, skyline[i].y);
+    if (y + height > ownership->height_) { return -1; }
+    remain -= skyline[i].width;
+  }
+  return y;
+}
@@ -0,0 +1,481 @@
+#include <lib/ResourceManager.h>
+
+#include <stdexcept>
+#include <algorithm>
+#include <filesystem>
+
+#include <SFML/System/Clock.hpp>
+
+std::vector<std::unique_ptr<ResourceManager::Entry>> ResourceManager::entries_;
+std::vector<usize> ResourceManager::free_codes_;
+std::map<std::pair<ResourceManager::ResourceType, std::string>, usize>
+    ResourceManager::codes_;
+std::deque<usize> ResourceManager::decode_queue_;
+std::deque<usize> ResourceManager::upload_queue_;
+std::vector<std::thread> ResourceManager::workers_;
+std::mutex ResourceManager::mutex_;
+std::condition_variable ResourceManager::condition_;
+usize ResourceManager::pending_count_ = usize(0);
+bool ResourceManager::is_running_ = false;
+u64 ResourceManager::use_clock_ = u64(0);
+usize ResourceManager::memory_budget_ = usize(0);
+usize ResourceManager::memory_usage_ = usize(0);
+usize ResourceManager::type_memory_usage_[
+    ResourceManager::kResourceTypeCount] = {};
+
+void ResourceManager::initialize(usize const &worker_count) {
+  ResourceManager::release();
+  usize count = worker_count;
+  if (count == 0) {
+    count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+  }
+  ResourceManager::is_running_ = true;
+  for (usize i = 0; i < count; ++i) {
+    ResourceManager::workers_.emplace_back(ResourceManager::work);
+  }
+}
+
+void ResourceManager::release() {
+  {
+    std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+    ResourceManager::is_running_ = false;
+  }
+  ResourceManager::condition_.notify_all();
+  for (std::thread &worker : ResourceManager::workers_) { worker.join(); }
+  ResourceManager::workers_.clear();
+  ResourceManager::decode_queue_.clear();
+  ResourceManager::upload_queue_.clear();
+  ResourceManager::entries_.clear();
+  ResourceManager::free_codes_.clear();
+  ResourceManager::codes_.clear();
+  ResourceManager::pending_count_ = 0;
+  ResourceManager::memory_usage_ = 0;
+  std::fill(ResourceManager::type_memory_usage_,
+            ResourceManager::type_memory_usage_ +
+            ResourceManager::kResourceTypeCount,
+            usize(0));
+}
+
+ResourceHandle ResourceManager::loadImage(std::string const &filename,
+                                          ImageProcess const &process) {
+  return ResourceManager::enqueue(ResourceManager::kImage, filename, process);
+}
+
+ResourceHandle ResourceManager::loadTexture(std::string const &filename,
+                                            ImageProcess const &process) {
+  return ResourceManager::enqueue(ResourceManager::kTexture, filename, process);
+}
+
+ResourceHandle ResourceManager::loadSoundBuffer(
+    std::string const &filename,
+    SoundBufferOptions const &options) {
+  return ResourceManager::enqueue(ResourceManager::kSoundBuffer, filename,
+                                  ImageProcess(), options);
+}
+
+ResourceHandle ResourceManager::loadFont(std::string const &filename) {
+  return ResourceManager::enqueue(ResourceManager::kFont, filename);
+}
+
+// call where the GL context is active, once per frame
+void ResourceManager::uploadPending(sf::Time const &budget) {
+  sf::Clock clock;
+  while (clock.getElapsedTime() < budget) {
+    Entry *entry;
+    usize resource_code;
+    {
+      std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+      if (ResourceManager::upload_queue_.empty()) { return; }
+      resource_code = ResourceManager::upload_queue_.front();
+      ResourceManager::upload_queue_.pop_front();
+      entry = ResourceManager::entries_[resource_code].get();
+    }
+    ResourceState state = ResourceManager::kReady;
+    try {
+      entry->texture_.loadFromImage(entry->image_.getImage());
+      entry->image_ = WrapImage();
+    } catch (std::exception const &e) {
+      entry->error_ = e.what();
+      state = ResourceManager::kFailed;
+    }
+    std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+    ResourceManager::finish(resource_code, state);
+  }
+}
+
+ResourceManager::ResourceState ResourceManager::getState(
+    usize const &resource_code) {
+  return ResourceManager::getEntry(resource_code).state_;
+}
+
+bool ResourceManager::isReady(usize const &resource_code) {
+  return ResourceManager::getState(resource_code) == ResourceManager::kReady;
+}
+
+std::string const &ResourceManager::getError(usize const &resource_code) {
+  return ResourceManager::getEntry(resource_code).error_;
+}
+
+usize ResourceManager::getPendingCount() {
+  std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+  return ResourceManager::pending_count_;
+}
+
+WrapImage const &ResourceManager::getImage(usize const &resource_code) {
+  return ResourceManager::readyCheck(resource_code,
+                                     ResourceManager::kImage).image_;
+}
+
+WrapTexture const &ResourceManager::getTexture(usize const &resource_code) {
+  return ResourceManager::readyCheck(resource_code,
+                                     ResourceManager::kTexture).texture_;
+}
+
+WrapSoundBuffer const &ResourceManager::getSoundBuffer(
+    usize const &resource_code) {
+  return ResourceManager::readyCheck(resource_code,
+                                     ResourceManager::kSoundBuffer
+                                     ).sound_buffer_;
+}
+
+sf::Font const &ResourceManager::getFont(usize const &resource_code) {
+  return ResourceManager::readyCheck(resource_code,
+                                     ResourceManager::kFont).font_;
+}
+
+usize ResourceManager::getReferenceCount(usize const &resource_code) {
+  Entry &entry = ResourceManager::getEntry(resource_code);
+  std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+  return entry.reference_count_;
+}
+
+ResourceManager::MemoryStats ResourceManager::getMemoryStats(
+    ResourceManager::ResourceType const &type) {
+  if (type >= ResourceManager::kResourceTypeCount) {
+    throw std::runtime_error("No exist resource type.");
+  }
+  std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+  MemoryStats stats = {};
+  for (std::unique_ptr<Entry> const &entry : ResourceManager::entries_) {
+    if (entry == nullptr || entry->type_ != type) { continue; }
+    ++stats.resource_count;
+    stats.referenced_count += entry->reference_count_ != 0;
+  }
+  stats.memory_usage = ResourceManager::type_memory_usage_[type];
+  return stats;
+}
+
+usize ResourceManager::getMemoryUsage() {
+  std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+  return ResourceManager::memory_usage_;
+}
+
+usize ResourceManager::getMemoryBudget() {
+  std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+  return ResourceManager::memory_budget_;
+}
+
+void ResourceManager::setMemoryBudget(usize const &memory_budget) {
+  std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+  ResourceManager::memory_budget_ = memory_budget;
+  ResourceManager::evict();
+}
+
+ResourceManager::Entry::Entry(ResourceManager::ResourceType const &type,
+                              std::string const &filename,
+                              ImageProcess const &process,
+                              SoundBufferOptions const &sound_options)
+    : type_(type),
+      filename_(filename),
+      process_(process),
+      sound_options_(sound_options),
+      state_(ResourceManager::kQueued),
+      reference_count_(0),
+      memory_usage_(0),
+      last_use_(0) {
+}
+
+ResourceHandle ResourceManager::enqueue(
+    ResourceManager::ResourceType const &type,
+    std::string const &filename,
+    ImageProcess const &process,
+    SoundBufferOptions const &sound_options) {
+  if (ResourceManager::workers_.empty()) {
+    throw std::runtime_error("ResourceManager is not initialized.");
+  }
+  std::pair<ResourceType, std::string> key(
+      type,
+      std::filesystem::path(filename).lexically_normal().generic_string());
+  usize resource_code;
+  {
+    std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+    auto found = ResourceManager::codes_.find(key);
+    if (found != ResourceManager::codes_.end()) {
+      Entry &entry = *ResourceManager::entries_[found->second];
+      ++entry.reference_count_;
+      entry.last_use_ = ++ResourceManager::use_clock_;
+      return ResourceHandle(found->second);
+    }
+    if (ResourceManager::free_codes_.empty()) {
+      resource_code = ResourceManager::entries_.size();
+      ResourceManager::entries_.emplace_back();
+    } else {
+      resource_code = ResourceManager::free_codes_.back();
+      ResourceManager::free_codes_.pop_back();
+    }
+    Entry *entry = new Entry(type, filename, process, sound_options);
+    entry->reference_count_ = 1;
+    entry->last_use_ = ++ResourceManager::use_clock_;
+    ResourceManager::entries_[resource_code].reset(entry);
+    ResourceManager::codes_[key] = resource_code;
+    ResourceManager::decode_queue_.push_back(resource_code);
+    ++ResourceManager::pending_count_;
+  }
+  ResourceManager::condition_.notify_one();
+  return ResourceHandle(resource_code);
+}
+
+void ResourceManager::work() {
+  while (true) {
+    Entry *entry;
+    usize resource_code;
+    {
+      std::unique_lock<std::mutex> lock(ResourceManager::mutex_);
+      ResourceManager::condition_.wait(lock, []() {
+        return !ResourceManager::decode_queue_.empty() ||
+               !ResourceManager::is_running_;
+      });
+      if (!ResourceManager::is_running_) { return; }
+      resource_code = ResourceManager::decode_queue_.front();
+      ResourceManager::decode_queue_.pop_front();
+      entry = ResourceManager::entries_[resource_code].get();
+    }
+    ResourceState state = ResourceManager::decode(*entry);
+    std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+    if (state == ResourceManager::kDecoded) {
+      entry->state_ = state;
+      ResourceManager::upload_queue_.push_back(resource_code);
+    } else {
+      ResourceManager::finish(resource_code, state);
+    }
+  }
+}
+
+// fills the entry but leaves state_ alone, it is published under mutex_
+ResourceManager::ResourceState ResourceManager::decode(
+    ResourceManager::Entry &entry) {
+  try {
+    switch (entry.type_) {
+      case ResourceManager::kImage:
+      case ResourceManager::kTexture:
+        entry.image_.loadFromFile(entry.filename_);
+        if (entry.process_) { entry.process_(entry.image_); }
+        return (entry.type_ == ResourceManager::kTexture ?
+                ResourceManager::kDecoded :
+                ResourceManager::kReady);
+      case ResourceManager::kSoundBuffer:
+        entry.sound_buffer_.loadFromFile(entry.filename_,
+                                         entry.sound_options_);
+        return ResourceManager::kReady;
+      case ResourceManager::kFont:
+        if (!entry.font_.loadFromFile(entry.filename_)) {
+          throw std::runtime_error(std::string("load from file failed: ") +
+                                   entry.filename_);
+        }
+        return ResourceManager::kReady;
+      default:
+        throw std::runtime_error("No exist resource type.");
+    }
+  } catch (std::exception const &e) {
+    entry.error_ = e.what();
+  }
+  return ResourceManager::kFailed;
+}
+
+// with mutex_ held, may erase the entry. until the state is published
+// here the entry is in flight, so drop() and evict() leave it alone
+void ResourceManager::finish(usize const &resource_code,
+                             ResourceManager::ResourceState const &state) {
+  Entry &entry = *ResourceManager::entries_[resource_code];
+  entry.state_ = state;
+  --ResourceManager::pending_count_;
+  if (entry.state_ == ResourceManager::kFailed &&
+      entry.reference_count_ == 0) {
+    ResourceManager::erase(resource_code); // every handle gone, allow a retry
+    return;
+  }
+  if (entry.state_ == ResourceManager::kReady) {
+    sf::Vector2u size;
+    std::error_code error;
+    switch (entry.type_) {
+      case ResourceManager::kImage:
+        size = entry.image_.getSize();
+        entry.memory_usage_ = usize(size.x) * size.y * 4;
+        break;
+      case ResourceManager::kTexture:
+        size = entry.texture_.getSize();
+        entry.memory_usage_ = usize(size.x) * size.y * 4;
+        break;
+      case ResourceManager::kSoundBuffer:
+        entry.memory_usage_ = entry.sound_buffer_.getMemoryUsage();
+        break;
+      case ResourceManager::kFont: // glyph pages grow later, count the face
+        entry.memory_usage_ = usize(std::filesystem::file_size(
+            entry.filename_, error));
+        if (error) { entry.memory_usage_ = 0; }
+        break;
+      default:
+        break;
+    }
+    ResourceManager::memory_usage_ += entry.memory_usage_;
+    ResourceManager::type_memory_usage_[entry.type_] += entry.memory_usage_;
+  }
+  ResourceManager::evict();
+}
+
+// with mutex_ held, least recently used unreferenced entries go first
+void ResourceManager::evict() {
+  if (ResourceManager::memory_budget_ == 0) { return; }
+  while (ResourceManager::memory_usage_ > ResourceManager::memory_budget_) {
+    usize victim = usize(-1);
+    for (usize i = 0; i < ResourceManager::entries_.size(); ++i) {
+      Entry const *entry = ResourceManager::entries_[i].get();
+      if (entry == nullptr || entry->reference_count_ != 0 ||
+          entry->state_ != ResourceManager::kReady) {
+        continue;
+      }
+      if (victim == usize(-1) ||
+          entry->last_use_ < ResourceManager::entries_[victim]->last_use_) {
+        victim = i;
+      }
+    }
+    if (victim == usize(-1)) { return; }
+    ResourceManager::erase(victim);
+  }
+}
+
+// with mutex_ held
+void ResourceManager::erase(usize const &resource_code) {
+  Entry &entry = *ResourceManager::entries_[resource_code];
+  ResourceManager::memory_usage_ -= entry.memory_usage_;
+  ResourceManager::type_memory_usage_[entry.type_] -= entry.memory_usage_;
+  ResourceManager::codes_.erase(std::make_pair(
+      entry.type_,
+      std::filesystem::path(entry.filename_).lexically_normal()
+          .generic_string()));
+  ResourceManager::entries_[resource_code].reset();
+  ResourceManager::free_codes_.push_back(resource_code);
+}
+
+void ResourceManager::retain(usize const &resource_code) noexcept {
+  std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+  if (resource_code >= ResourceManager::entries_.size() ||
+      ResourceManager::entries_[resource_code] == nullptr) {
+    return;
+  }
+  ++ResourceManager::entries_[resource_code]->reference_count_;
+}
+
+void ResourceManager::drop(usize const &resource_code) noexcept {
+  std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+  if (resource_code >= ResourceManager::entries_.size() ||
+      ResourceManager::entries_[resource_code] == nullptr) {
+    return; // released already
+  }
+  Entry &entry = *ResourceManager::entries_[resource_code];
+  if (--entry.reference_count_ != 0) { return; }
+  if (entry.state_ == ResourceManager::kFailed) {
+    ResourceManager::erase(resource_code); // let a later load retry
+  } else {
+    ResourceManager::evict();
+  }
+}
+
+ResourceManager::Entry &ResourceManager::readyCheck(
+    usize const &resource_code,
+    ResourceManager::ResourceType const &type) {
+  Entry &entry = ResourceManager::getEntry(resource_code);
+  if (entry.type_ != type) {
+    throw std::runtime_error("resource_code refers to another type.");
+  }
+  if (entry.state_ == ResourceManager::kFailed) {
+    throw std::runtime_error(entry.error_);
+  }
+  if (entry.state_ != ResourceManager::kReady) {
+    throw std::runtime_error("resource is not ready yet: " + entry.filename_);
+  }
+  return entry;
+}
+
+ResourceManager::Entry &ResourceManager::getEntry(
+    usize const &resource_code) {
+  std::lock_guard<std::mutex> lock(ResourceManager::mutex_);
+  if (resource_code >= ResourceManager::entries_.size() ||
+      ResourceManager::entries_[resource_code] == nullptr) {
+    throw std::runtime_error("No exist resource_code.");
+  }
+  Entry &entry = *ResourceManager::entries_[resource_code];
+  entry.last_use_ = ++ResourceManager::use_clock_;
+  return entry;
+}
+
+ResourceHandle::ResourceHandle() noexcept
+    : resource_code_(usize(-1)) {
+}
+
+ResourceHandle::ResourceHandle(ResourceHandle const &rhs) noexcept
+    : resource_code_(rhs.resource_code_) {
+  if (!this->isNull()) { ResourceManager::retain(resource_code_); }
+}
+
+ResourceHandle &ResourceHandle::operator=(ResourceHandle const &rhs) noexcept {
+  if (this == &rhs) { return *this; }
+  if (!rhs.isNull()) { ResourceManager::retain(rhs.resource_code_); }
+  if (!this->isNull()) { ResourceManager::drop(resource_code_); }
+  resource_code_ = rhs.resource_code_;
+  return *this;
+}
+
+ResourceHandle::~ResourceHandle() noexcept {
+  if (!this->isNull()) { ResourceManager::drop(resource_code_); }
+}
+
+usize const &ResourceHandle::getCode() const noexcept {
+  return resource_code_;
+}
+
+bool ResourceHandle::isNull() const noexcept {
+  return resource_code_ == usize(-1);
+}
+
+ResourceManager::ResourceState ResourceHandle::getState() const {
+  return ResourceManager::getState(resource_code_);
+}
+
+bool ResourceHandle::isReady() const {
+  return ResourceManager::isReady(resource_code_);
+}
+
+std::string const &ResourceHandle::getError() const {
+  return ResourceManager::getError(resource_code_);
+}
+
+WrapImage const &ResourceHandle::getImage() const {
+  return ResourceManager::getImage(resource_code_);
+}
+
+WrapTexture const &ResourceHandle::getTexture() const {
+  return ResourceManager::getTexture(resource_code_);
+}
+
+WrapSoundBuffer const &ResourceHandle::getSoundBuffer() const {
+  return ResourceManager::getSoundBuffer(resource_code_);
+}
+
+sf::Font const &ResourceHandle::getFont() const {
+  return ResourceManager::getFont(resource_code_);
+}
+
+ResourceHandle::ResourceHandle(usize const &resource_code) noexcept
+    : resource_code_(resource_code) {
+}
@@ -0,0 +1,271 @@
+#include <lib/SoundManager.h>
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+std::vector<SoundManager::Sound> SoundManager::sounds_;
+std::vector<SoundManager::Voice> SoundManager::voices_;
+u64 SoundManager::frame_ = u64(1);
+u64 SoundManager::start_clock_ = u64(0);
+sf::Vector2f SoundManager::listener_position_;
+
+void SoundManager::initialize(usize const &voice_count) {
+  if (voice_count == 0) {
+    throw std::runtime_error("voice_count must be greater than 0.");
+  }
+  SoundManager::release();
+  SoundManager::voices_.resize(voice_count);
+  for (Voice &voice : SoundManager::voices_) {
+    voice.sound_code_ = usize(-1);
+    voice.priority_ = 0;
+    voice.start_ = 0;
+    voice.volume_ = 0.0f;
+    voice.is_positional_ = false;
+    voice.audible_range_ = 0.0f;
+    // gains and panning are computed here, not by openal distance models
+    voice.sound_.setRelativeToListener(true);
+    voice.sound_.setAttenuation(0.0f);
+  }
+}
+
+void SoundManager::release() {
+  SoundManager::stopAll();
+  SoundManager::voices_.clear();
+  SoundManager::sounds_.clear();
+}
+
+usize SoundManager::registerSound(WrapSoundBuffer const &sound_buffer,
+                                  usize const &max_voice,
+                                  i32 const &priority) {
+  if (max_voice == 0) {
+    throw std::runtime_error("max_voice must be greater than 0.");
+  }
+  SoundManager::sounds_.push_back(Sound({
+    &sound_buffer, max_voice, priority, u64(0), SoundManager::frame_,
+    usize(-1),
+  }));
+  return SoundManager::sounds_.size() - 1;
+}
+
+usize const &SoundManager::getMaxVoice(usize const &sound_code) {
+  SoundManager::codeCheck(sound_code);
+  return SoundManager::sounds_[sound_code].max_voice_;
+}
+
+void SoundManager::setMaxVoice(usize const &sound_code,
+                               usize const &max_voice) {
+  SoundManager::codeCheck(sound_code);
+  if (max_voice == 0) {
+    throw std::runtime_error("max_voice must be greater than 0.");
+  }
+  SoundManager::sounds_[sound_code].max_voice_ = max_voice;
+}
+
+i32 const &SoundManager::getPriority(usize const &sound_code) {
+  SoundManager::codeCheck(sound_code);
+  return SoundManager::sounds_[sound_code].priority_;
+}
+
+void SoundManager::setPriority(usize const &sound_code, i32 const &priority) {
+  SoundManager::codeCheck(sound_code);
+  SoundManager::sounds_[sound_code].priority_ = priority;
+}
+
+usize SoundManager::play(usize const &sound_code,
+                         f32 const &volume,
+                         f32 const &pitch) {
+  SoundManager::codeCheck(sound_code);
+  usize voice_code = SoundManager::start(sound_code, volume, pitch);
+  if (voice_code == usize(-1)) { return usize(-1); }
+  Voice &voice = SoundManager::voices_[voice_code];
+  voice.is_positional_ = false;
+  voice.sound_.setPosition(0.0f, 0.0f, 0.0f);
+  voice.sound_.setVolume(volume);
+  voice.sound_.play();
+  return voice_code;
+}
+
+usize SoundManager::playAt(usize const &sound_code,
+                           sf::Vector2f const &position,
+                           f32 const &audible_range,
+                           f32 const &volume,
+                           f32 const &pitch) {
+  SoundManager::codeCheck(sound_code);
+  f32 attenuation = SoundManager::getAttenuation(position, audible_range);
+  if (attenuation <= 0.0f) { return usize(-1); }
+  Sound const &sound = SoundManager::sounds_[sound_code];
+  if (sound.trigger_frame_ == SoundManager::frame_) {
+    // deduplicated, the nearest trigger of the frame wins the voice
+    if (sound.trigger_voice_ == usize(-1)) { return usize(-1); }
+    Voice &voice = SoundManager::voices_[sound.trigger_voice_];
+    if (voice.sound_code_ == sound_code && voice.is_positional_ &&
+        attenuation > SoundManager::getAttenuation(voice.position_,
+                                                   voice.audible_range_)) {
+      voice.position_ = position;
+      voice.audible_range_ = audible_range;
+      SoundManager::spatialize(voice);
+    }
+    return usize(-1);
+  }
+  usize voice_code = SoundManager::start(sound_code, volume, pitch);
+  if (voice_code == usize(-1)) { return usize(-1); }
+  Voice &voice = SoundManager::voices_[voice_code];
+  voice.is_positional_ = true;
+  voice.position_ = position;
+  voice.audible_range_ = audible_range;
+  SoundManager::spatialize(voice);
+  voice.sound_.play();
+  return voice_code;
+}
+
+void SoundManager::stop(usize const &sound_code) {
+  SoundManager::codeCheck(sound_code);
+  for (Voice &voice : SoundManager::voices_) {
+    if (voice.sound_code_ == sound_code) { voice.sound_.stop(); }
+  }
+}
+
+void SoundManager::stopAll() {
+  for (Voice &voice : SoundManager::voices_) { voice.sound_.stop(); }
+}
+
+void SoundManager::framework() {
+  for (Voice &voice : SoundManager::voices_) {
+    if (voice.is_positional_ && SoundManager::isActive(voice) &&
+        SoundManager::spatialize(voice) <= 0.0f) {
+      voice.sound_.stop(); // walked out of range
+    }
+    if (SoundManager::isActive(voice)) {
+      SoundManager::sounds_[voice.sound_code_].active_frame_ =
+          SoundManager::frame_;
+    }
+  }
+  for (Sound &sound : SoundManager::sounds_) {
+    if (sound.sound_buffer_->isCompressed() &&
+        sound.sound_buffer_->isDecoded() &&
+        SoundManager::frame_ - sound.active_frame_ >
+            SoundManager::kDecodedLifetime) {
+      sound.sound_buffer_->releaseDecoded();
+    }
+  }
+  ++SoundManager::frame_;
+}
+
+sf::Vector2f const &SoundManager::getListenerPosition() noexcept {
+  return SoundManager::listener_position_;
+}
+
+void SoundManager::setListenerPosition(sf::Vector2f const &position) noexcept {
+  SoundManager::listener_position_ = position;
+}
+
+f32 SoundManager::getAttenuation(sf::Vector2f const &position,
+                                 f32 const &audible_range) {
+  if (audible_range <= 0.0f) { return 0.0f; }
+  sf::Vector2f offset = position - SoundManager::listener_position_;
+  f32 distance = std::hypot(offset.x, offset.y);
+  return std::max(1.0f - distance / audible_range, 0.0f);
+}
+
+usize SoundManager::getVoiceCount() noexcept {
+  return SoundManager::voices_.size();
+}
+
+usize SoundManager::getActiveVoiceCount() {
+  usize count = 0;
+  for (Voice const &voice : SoundManager::voices_) {
+    count += SoundManager::isActive(voice);
+  }
+  return count;
+}
+
+usize SoundManager::getActiveVoiceCount(usize const &sound_code) {
+  SoundManager::codeCheck(sound_code);
+  usize count = 0;
+  for (Voice const &voice : SoundManager::voices_) {
+    count += (voice.sound_code_ == sound_code && SoundManager::isActive(voice));
+  }
+  return count;
+}
+
+void SoundManager::codeCheck(usize const &sound_code) {
+  if (sound_code >= SoundManager::sounds_.size()) {
+    throw std::runtime_error("No exist sound_code.");
+  }
+}
+
+bool SoundManager::isActive(SoundManager::Voice const &voice) {
+  return voice.sound_.getStatus() != sf::SoundSource::Stopped;
+}
+
+// the sound's own oldest voice once it hits max_voice, then a free voice,
+// then the oldest of the lowest priority voices not above the sound's
+usize SoundManager::findVoice(usize const &sound_code) {
+  Sound const &sound = SoundManager::sounds_[sound_code];
+  usize own_count = 0;
+  usize own_oldest = usize(-1);
+  usize free = usize(-1);
+  usize victim = usize(-1);
+  for (usize i = 0; i < SoundManager::voices_.size(); ++i) {
+    Voice const &voice = SoundManager::voices_[i];
+    if (!SoundManager::isActive(voice)) {
+      if (free == usize(-1)) { free = i; }
+      continue;
+    }
+    if (voice.sound_code_ == sound_code) {
+      ++own_count;
+      if (own_oldest == usize(-1) ||
+          voice.start_ < SoundManager::voices_[own_oldest].start_) {
+        own_oldest = i;
+      }
+    }
+    if (voice.priority_ > sound.priority_) { continue; }
+    if (victim == usize(-1) ||
+        voice.priority_ < SoundManager::voices_[victim].priority_ ||
+        (voice.priority_ == SoundManager::voices_[victim].priority_ &&
+         voice.start_ < SoundManager::voices_[victim].start_)) {
+      victim = i;
+    }
+  }
+  if (own_count >= sound.max_voice_) { return own_oldest; }
+  if (free != usize(-1)) { return free; }
+  return victim;
+}
+
+// claims a voice and binds the buffer, the caller positions and plays it
+usize SoundManager::start(usize const &sound_code,
+                          f32 const &volume,
+                          f32 const &pitch) {
+  Sound &sound = SoundManager::sounds_[sound_code];
+  if (sound.trigger_frame_ == SoundManager::frame_) { return usize(-1); }
+  usize voice_code = SoundManager::findVoice(sound_code);
+  if (voice_code == usize(-1)) { return usize(-1); }
+  sound.trigger_frame_ = SoundManager::frame_;
+  sound.active_frame_ = SoundManager::frame_;
+  sound.trigger_voice_ = voice_code;
+
+  Voice &voice = SoundManager::voices_[voice_code];
+  voice.sound_.stop();
+  sf::SoundBuffer const &sound_buffer = sound.sound_buffer_->getSoundBuffer();
+  if (voice.sound_.getBuffer() != &sound_buffer) {
+    voice.sound_.setBuffer(sound_buffer);
+  }
+  voice.sound_.setPitch(pitch);
+  voice.sound_code_ = sound_code;
+  voice.priority_ = sound.priority_;
+  voice.start_ = ++SoundManager::start_clock_;
+  voice.volume_ = volume;
+  return voice_code;
+}
+
+// attenuates by distance and pans by the horizontal offset
+f32 SoundManager::spatialize(SoundManager::Voice &voice) {
+  f32 attenuation = SoundManager::getAttenuation(voice.position_,
+                                                 voice.audible_range_);
+  f32 pan = (voice.position_.x - SoundManager::listener_position_.x) /
+            voice.audible_range_;
+  voice.sound_.setPosition(std::min(std::max(pan, -1.0f), 1.0f), 0.0f, -1.0f);
+  voice.sound_.setVolume(voice.volume_ * attenuation);
+  return attenuation;
+}
@@ -0,0 +1,352 @@
+#include <lib/SpriteAtlas.h>
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+using i32 = int;
+using i64 = long long;
+using u8 = unsigned char;
+using u32 = unsigned int;
+using u64 = unsigned long long;
+using f32 = float;
+
+static constexpr u32 kAtlasMagic = 0x4c544153; // "SATL"
+static constexpr u32 kAtlasVersion = 1;
+static constexpr u32 kMaxPageCount = 4096;
+static constexpr u64 kAnimeBytes = 8;  // name length and frame count
+static constexpr u64 kFrameBytes = 40;
+
+static std::string pageFilename(std::string const &filename,
+                                usize const &page_code) {
+  usize dot = filename.find_last_of('.');
+  usize slash = filename.find_last_of("/\\");
+  std::string stem = (dot != std::string::npos &&
+                      (slash == std::string::npos || dot > slash) ?
+                      filename.substr(0, dot) :
+                      filename);
+  return stem + '.' + std::to_string(page_code) + ".png";
+}
+
+// little endian regardless of host
+static void writeU32(std::ostream &out, u32 const &value) {
+  u8 bytes[4] = {
+    u8(value), u8(value >> 8), u8(value >> 16), u8(value >> 24),
+  };
+  out.write(reinterpret_cast<char const *>(bytes), sizeof(bytes));
+}
+
+static void writeU64(std::ostream &out, u64 const &value) {
+  writeU32(out, u32(value));
+  writeU32(out, u32(value >> 32));
+}
+
+static void writeF32(std::ostream &out, f32 const &value) {
+  u32 bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  writeU32(out, bits);
+}
+
+static void writeString(std::ostream &out, std::string const &value) {
+  writeU32(out, u32(value.size()));
+  out.write(value.data(), value.size());
+}
+
+static u32 readU32(std::istream &in) {
+  u8 bytes[4];
+  if (!in.read(reinterpret_cast<char *>(bytes), sizeof(bytes))) {
+    throw std::runtime_error("atlas index truncated");
+  }
+  return u32(bytes[0]) | u32(bytes[1]) << 8 |
+         u32(bytes[2]) << 16 | u32(bytes[3]) << 24;
+}
+
+static u64 readU64(std::istream &in) {
+  u64 low = readU32(in);
+  return low | u64(readU32(in)) << 32;
+}
+
+static f32 readF32(std::istream &in) {
+  u32 bits = readU32(in);
+  f32 value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+// bytes left after the read position, counts read from the file are
+// checked against it before anything gets allocated for them
+static u64 remainingBytes(std::istream &in) {
+  std::streampos position = in.tellg();
+  in.seekg(0, std::ios::end);
+  std::streampos end = in.tellg();
+  in.seekg(position);
+  if (position < 0 || end < position) {
+    throw std::runtime_error("atlas index unreadable");
+  }
+  return u64(end - position);
+}
+
+static u32 readCount(std::istream &in, u64 const &element_bytes) {
+  u32 count = readU32(in);
+  if (u64(count) * element_bytes > remainingBytes(in)) {
+    throw std::runtime_error("atlas index truncated");
+  }
+  return count;
+}
+
+static std::string readString(std::istream &in) {
+  std::string value(readCount(in, 1), '\0');
+  if (!in.read(&value[0], value.size())) {
+    throw std::runtime_error("atlas index truncated");
+  }
+  return value;
+}
+
+SpriteAtlas::SpriteAtlas()
+    : ownership(new SpriteAtlas::Inner()) {
+}
+
+SpriteAtlas::SpriteAtlas(std::string const &filename)
+    : ownership(new SpriteAtlas::Inner()) {
+  this->loadFromFile(filename);
+}
+
+SpriteAtlas::SpriteAtlas(SpriteAtlas const &rhs) noexcept
+    : ownership() {
+  *this = rhs;
+}
+
+SpriteAtlas &SpriteAtlas::operator=(SpriteAtlas const &rhs) noexcept {
+  if (this == &rhs) { return *this; }
+  if (ownership != nullptr) { delete ownership; }
+  ownership = rhs.ownership;
+  const_cast<SpriteAtlas &>(rhs).ownership = nullptr;
+  return *this;
+}
+
+SpriteAtlas::~SpriteAtlas() noexcept {
+  if (ownership != nullptr) { delete ownership; }
+}
+
+SpriteAtlas SpriteAtlas::clone() const {
+  this->ownershipCheck();
+  return SpriteAtlas(new SpriteAtlas::Inner(*ownership));
+}
+
+void SpriteAtlas::create(WrapImages const &pages,
+                         std::vector<std::string> const &names,
+                         AtlasFramesStore const &frames_store) {
+  this->ownershipCheck();
+  if (names.size() != frames_store.size()) {
+    throw std::runtime_error("names mismatch frames_store.");
+  }
+  for (AtlasFrames const &frames : frames_store) {
+    for (AtlasFrame const &frame : frames) {
+      if (frame.page >= pages.size()) {
+        throw std::runtime_error("No exist page.");
+      }
+    }
+  }
+  ownership->images_.clear();
+  for (WrapImage const &page : pages) {
+    ownership->images_.push_back(page.clone());
+  }
+  ownership->textures_.clear();
+  ownership->names_.assign(names.begin(), names.end());
+  ownership->frames_store_.assign(frames_store.begin(), frames_store.end());
+}
+
+void SpriteAtlas::loadFromFile(std::string const &filename) {
+  this->ownershipCheck();
+  std::ifstream in(filename, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error(std::string("load from file failed: ") + filename);
+  }
+  if (readU32(in) != kAtlasMagic) {
+    throw std::runtime_error(std::string("not an atlas index: ") + filename);
+  }
+  if (readU32(in) != kAtlasVersion) {
+    throw std::runtime_error(std::string("unknown atlas version: ") + filename);
+  }
+  usize page_count = readU32(in);
+  if (page_count > kMaxPageCount) {
+    throw std::runtime_error(std::string("broken atlas index: ") + filename);
+  }
+  std::vector<std::string> names(readCount(in, kAnimeBytes));
+  AtlasFramesStore frames_store(names.size());
+  for (usize i = 0; i < names.size(); ++i) {
+    names[i] = readString(in);
+    frames_store[i].resize(readCount(in, kFrameBytes));
+    for (AtlasFrame &frame : frames_store[i]) {
+      frame.page = readU32(in);
+      frame.rect.left = i32(readU32(in));
+      frame.rect.top = i32(readU32(in));
+      frame.rect.width = i32(readU32(in));
+      frame.rect.height = i32(readU32(in));
+      frame.is_rotated = readU32(in) != 0;
+      frame.origin.x = readF32(in);
+      frame.origin.y = readF32(in);
+      frame.duration = sf::microseconds(i64(readU64(in)));
+      if (frame.page >= page_count) {
+        throw std::runtime_error(std::string("broken atlas index: ") +
+                                 filename);
+      }
+    }
+  }
+  WrapTextures textures(page_count);
+  for (usize i = 0; i < page_count; ++i) {
+    textures[i].loadFromFile(pageFilename(filename, i));
+  }
+  ownership->images_.clear();
+  ownership->textures_.assign(textures.begin(), textures.end());
+  ownership->names_.swap(names);
+  ownership->frames_store_.swap(frames_store);
+}
+
+void SpriteAtlas::saveToFile(std::string const &filename) const {
+  this->ownershipCheck();
+  if (ownership->images_.empty() && !ownership->textures_.empty()) {
+    throw std::runtime_error("atlas has no page images to save");
+  }
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("save to file failed");
+  }
+  writeU32(out, kAtlasMagic);
+  writeU32(out, kAtlasVersion);
+  writeU32(out, u32(ownership->images_.size()));
+  writeU32(out, u32(ownership->names_.size()));
+  for (usize i = 0; i < ownership->names_.size(); ++i) {
+    writeString(out, ownership->names_[i]);
+    writeU32(out, u32(ownership->frames_store_[i].size()));
+    for (AtlasFrame const &frame : ownership->frames_store_[i]) {
+      writeU32(out, u32(frame.page));
+      writeU32(out, u32(frame.rect.left));
+      writeU32(out, u32(frame.rect.top));
+      writeU32(out, u32(frame.rect.width));
+      writeU32(out, u32(frame.rect.height));
+      writeU32(out, u32(frame.is_rotated));
+      writeF32(out, frame.origin.x);
+      writeF32(out, frame.origin.y);
+      writeU64(out, u64(frame.duration.asMicroseconds()));
+    }
+  }
+  if (!out) {
+    throw std::runtime_error("save to file failed");
+  }
+  for (usize i = 0; i < ownership->images_.size(); ++i) {
+    ownership->images_[i].saveToFile(pageFilename(filename, i));
+  }
+}
+
+usize SpriteAtlas::getPageCount() const {
+  this->ownershipCheck();
+  return std::max(ownership->images_.size(), ownership->textures_.size());
+}
+
+WrapTexture const &SpriteAtlas::getTexture(usize const &page_code) const {
+  this->ownershipCheck();
+  if (page_code >= this->getPageCount()) {
+    throw std::runtime_error("No exist page_code.");
+  }
+  if (ownership->textures_.empty()) {
+    for (WrapImage const &image : ownership->images_) {
+      ownership->textures_.push_back(WrapTexture(image.getImage()));
+    }
+  }
+  return ownership->textures_[page_code];
+}
+
+usize SpriteAtlas::getAnimeCount() const {
+  this->ownershipCheck();
+  return ownership->names_.size();
+}
+
+usize SpriteAtlas::getAnimeCode(std::string const &name) const {
+  this->ownershipCheck();
+  for (usize i = 0; i < ownership->names_.size(); ++i) {
+    if (ownership->names_[i] == name) { return i; }
+  }
+  throw std::runtime_error(std::string("No exist anime name: ") + name);
+}
+
+std::string const &SpriteAtlas::getAnimeName(usize const &anime_code) const {
+  this->codeCheck(anime_code);
+  return ownership->names_[anime_code];
+}
+
+AtlasFrames const &SpriteAtlas::getFrames(usize const &anime_code) const {
+  this->codeCheck(anime_code);
+  return ownership->frames_store_[anime_code];
+}
+
+AtlasFrame const &SpriteAtlas::getFrame(usize const &anime_code,
+                                        usize const &frame_code) const {
+  this->codeCheck(anime_code, frame_code);
+  return ownership->frames_store_[anime_code][frame_code];
+}
+
+Animation SpriteAtlas::generateAnimation() const {
+  this->ownershipCheck();
+  Animation animation(ownership->frames_store_.size());
+  for (usize i = 0; i < ownership->frames_store_.size(); ++i) {
+    AtlasFrames const &frames = ownership->frames_store_[i];
+    Anime anime(frames.size());
+    for (usize j = 0; j < frames.size(); ++j) {
+      if (frames[j].is_rotated) {
+        throw std::runtime_error("rotated frame has no Motion: " +
+                                 ownership->names_[i]);
+      }
+      anime[j] = Motion(frames[j].rect, frames[j].duration);
+    }
+    animation.setAnime(i, anime);
+  }
+  return Animation(animation);
+}
+
+SpriteAtlas::Inner::Inner() {
+}
+
+SpriteAtlas::Inner::Inner(SpriteAtlas::Inner const &rhs) {
+  *this = rhs;
+}
+
+SpriteAtlas::Inner &SpriteAtlas::Inner::operator=(
+    SpriteAtlas::Inner const &rhs) {
+  if (this == &rhs) { return *this; }
+  this->images_.clear();
+  for (WrapImage const &image : rhs.images_) {
+    this->images_.push_back(image.clone());
+  }
+  this->textures_.clear();
+  for (WrapTexture const &texture : rhs.textures_) {
+    this->textures_.push_back(texture.clone());
+  }
+  this->names_.assign(rhs.names_.begin(), rhs.names_.end());
+  this->frames_store_.assign(rhs.frames_store_.begin(),
+                             rhs.frames_store_.end());
+  return *this;
+}
+
+SpriteAtlas::SpriteAtlas(SpriteAtlas::Inner *const &ownership) noexcept
+    : ownership(ownership) {
+}
+
+void SpriteAtlas::ownershipCheck() const {
+  if (ownership == nullptr) {
+    throw std::runtime_error("No ownership rights whatsoever: SpriteAtlas");
+  }
+}
+
+void SpriteAtlas::codeCheck(usize const &anime_code,
+                            usize const &frame_code) const {
+  this->ownershipCheck();
+  if (anime_code >= ownership->frames_store_.size()) {
+    throw std::runtime_error("No exist anime_code.");
+  }
+  if (frame_code != usize(-1) &&
+      frame_code >= ownership->frames_store_[anime_code].size()) {
+    throw std::runtime_error("No exist frame_code.");
+  }
+}
@@ -0,0 +1,292 @@
+#include <lib/SpriteBatch.h>
+
+#include <stdexcept>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+SpriteBatch::SpriteBatch()
+    : ownership(new SpriteBatch::Inner()) {
+}
+
+SpriteBatch::SpriteBatch(SpriteBatch const &rhs) noexcept
+    : ownership() {
+  *this = rhs;
+}
+
+SpriteBatch &SpriteBatch::operator=(SpriteBatch const &rhs) noexcept {
+  if (this == &rhs) { return *this; }
+  if (ownership != nullptr) { delete ownership; }
+  ownership = rhs.ownership;
+  const_cast<SpriteBatch &>(rhs).ownership = nullptr;
+  return *this;
+}
+
+SpriteBatch::~SpriteBatch() noexcept {
+  if (ownership != nullptr) { delete ownership; }
+}
+
+SpriteBatch SpriteBatch::clone() const {
+  this->ownershipCheck();
+  return SpriteBatch(new SpriteBatch::Inner(*ownership));
+}
+
+// keeps every buffer's capacity for the next frame
+void SpriteBatch::clear() {
+  this->ownershipCheck();
+  ownership->items_.clear();
+  ownership->order_.clear();
+  ownership->texture_codes_.clear();
+  ownership->batch_count_ = 0;
+  ownership->is_built_ = false;
+}
+
+void SpriteBatch::reserve(usize const &sprite_count) {
+  this->ownershipCheck();
+  ownership->items_.reserve(sprite_count);
+  ownership->order_.reserve(sprite_count);
+  ownership->swap_order_.reserve(sprite_count);
+}
+
+void SpriteBatch::draw(sf::Texture const *const &texture,
+                       sf::IntRect const &texture_rect,
+                       sf::Vector2f const &size,
+                       sf::Transform const &transform,
+                       SpriteBatch::Layer const &layer,
+                       f32 const &z_depth,
+                       sf::Color const &color) {
+  this->ownershipCheck();
+  f32 left = f32(texture_rect.left);
+  f32 top = f32(texture_rect.top);
+  f32 right = left + texture_rect.width;
+  f32 bottom = top + texture_rect.height;
+  Item item;
+  item.key_ = this->makeKey(texture, layer, z_depth);
+  item.texture_ = texture;
+  item.vertices_[0] = sf::Vertex(transform.transformPoint(0.0f, 0.0f),
+                                 color, sf::Vector2f(left, top));
+  item.vertices_[1] = sf::Vertex(transform.transformPoint(size.x, 0.0f),
+                                 color, sf::Vector2f(right, top));
+  item.vertices_[2] = sf::Vertex(transform.transformPoint(size.x, size.y),
+                                 color, sf::Vector2f(right, bottom));
+  item.vertices_[3] = sf::Vertex(transform.transformPoint(0.0f, size.y),
+                                 color, sf::Vector2f(left, bottom));
+  ownership->items_.push_back(item);
+  ownership->is_built_ = false;
+}
+
+void SpriteBatch::draw(sf::Sprite const &sprite,
+                       SpriteBatch::Layer const &layer,
+                       f32 const &z_depth) {
+  sf::IntRect const &texture_rect = sprite.getTextureRect();
+  this->draw(sprite.getTexture(), texture_rect,
+             sf::Vector2f(std::abs(texture_rect.width),
+                          std::abs(texture_rect.height)),
+             sprite.getTransform(), layer, z_depth, sprite.getColor());
+}
+
+void SpriteBatch::draw(sf::RectangleShape const &shape,
+                       SpriteBatch::Layer const &layer,
+                       f32 const &z_depth) {
+  this->draw(shape.getTexture(), shape.getTextureRect(), shape.getSize(),
+             shape.getTransform(), layer, z_depth, shape.getFillColor());
+}
+
+void SpriteBatch::draw(SpriteAtlas const &atlas,
+                       AtlasFrame const &frame,
+                       sf::Transform const &transform,
+                       SpriteBatch::Layer const &layer,
+                       f32 const &z_depth,
+                       sf::Color const &color) {
+  sf::IntRect const &rect = frame.rect;
+  sf::Texture const *texture = &atlas.getTexture(frame.page).getTexture();
+  if (!frame.is_rotated) {
+    this->draw(texture, rect, sf::Vector2f(rect.width, rect.height),
+               transform, layer, z_depth, color);
+    return;
+  }
+  // stored a quarter turn clockwise, texcoords go around one corner later
+  this->draw(texture, rect, sf::Vector2f(rect.height, rect.width),
+             transform, layer, z_depth, color);
+  Item &item = ownership->items_.back();
+  f32 left = f32(rect.left);
+  f32 top = f32(rect.top);
+  f32 right = left + rect.width;
+  f32 bottom = top + rect.height;
+  item.vertices_[0].texCoords = sf::Vector2f(right, top);
+  item.vertices_[1].texCoords = sf::Vector2f(right, bottom);
+  item.vertices_[2].texCoords = sf::Vector2f(left, bottom);
+  item.vertices_[3].texCoords = sf::Vector2f(left, top);
+}
+
+void SpriteBatch::draw(sf::Texture const *const &texture,
+                       MotionQuad const &quad,
+                       sf::Transform const &transform,
+                       SpriteBatch::Layer const &layer,
+                       f32 const &z_depth,
+                       sf::Color const &color) {
+  this->ownershipCheck();
+  ownership->items_.emplace_back();
+  Item &item = ownership->items_.back();
+  item.key_ = this->makeKey(texture, layer, z_depth);
+  item.texture_ = texture;
+  for (usize i = 0; i < 4; ++i) {
+    item.vertices_[i] = sf::Vertex(transform.transformPoint(
+        quad.positions[i]), color, quad.tex_coords[i]);
+  }
+  ownership->is_built_ = false;
+}
+
+void SpriteBatch::render(sf::RenderTarget &target,
+                         sf::RenderStates const &states) {
+  this->ownershipCheck();
+  this->build();
+  sf::RenderStates batch_states(states);
+  for (usize i = 0; i < ownership->batch_count_; ++i) {
+    Batch const &batch = ownership->batches_[i];
+    batch_states.texture = batch.texture_;
+    target.draw(batch.vertices_, batch_states);
+  }
+}
+
+usize SpriteBatch::getSpriteCount() const {
+  this->ownershipCheck();
+  return ownership->items_.size();
+}
+
+usize SpriteBatch::getDrawCallCount() const {
+  this->ownershipCheck();
+  return ownership->batch_count_;
+}
+
+SpriteBatch::SpriteBatch(SpriteBatch::Inner *const &ownership) noexcept
+    : ownership(ownership) {
+}
+
+void SpriteBatch::ownershipCheck() const {
+  if (ownership == nullptr) {
+    throw std::runtime_error("No ownership rights whatsoever: SpriteBatch");
+  }
+}
+
+u32 SpriteBatch::makeKey(sf::Texture const *const &texture,
+                         SpriteBatch::Layer const &layer,
+                         f32 const &z_depth) {
+  // float bits flipped so unsigned order follows numeric order, the top
+  // 16 bits keep sign, exponent and 7 bits of mantissa
+  u32 bits;
+  std::memcpy(&bits, &z_depth, sizeof(u32));
+  bits = (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+
+  // small per frame texture codes, past 4095 textures only batching suffers
+  std::vector<std::pair<sf::Texture const *, u32>> &texture_codes =
+      ownership->texture_codes_;
+  u32 texture_code = u32(texture_codes.size());
+  for (std::pair<sf::Texture const *, u32> const &texture_pair :
+       texture_codes) {
+    if (texture_pair.first == texture) {
+      texture_code = texture_pair.second;
+      break;
+    }
+  }
+  if (texture_code == texture_codes.size()) {
+    texture_codes.emplace_back(texture, texture_code);
+  }
+  texture_code = std::min(texture_code, 0xfffu);
+
+  return (u32(std::min(layer, kLayerCount)) & 0xfu) << 28 |
+         (bits >> 16) << 12 |
+         texture_code;
+}
+
+// lsd radix sort, 8 bits a pass, passes where every key shares the byte
+// are skipped, both buffers keep their capacity across frames
+void SpriteBatch::sort() {
+  std::vector<Item> const &items = ownership->items_;
+  std::vector<SortEntry> &order = ownership->order_;
+  std::vector<SortEntry> &swap_order = ownership->swap_order_;
+  order.resize(items.size());
+  swap_order.resize(items.size());
+  for (usize i = 0; i < order.size(); ++i) {
+    order[i] = SortEntry({ items[i].key_, u32(i) });
+  }
+  if (order.empty()) { return; }
+  for (u32 shift = 0; shift < 32; shift += 8) {
+    usize counts[256] = {};
+    for (SortEntry const &entry : order) {
+      ++counts[(entry.key_ >> shift) & 0xffu];
+    }
+    if (counts[(order[0].key_ >> shift) & 0xffu] == order.size()) {
+      continue;
+    }
+    usize offset = 0;
+    for (usize &count : counts) {
+      usize next = offset + count;
+      count = offset;
+      offset = next;
+    }
+    for (SortEntry const &entry : order) {
+      swap_order[counts[(entry.key_ >> shift) & 0xffu]++] = entry;
+    }
+    order.swap(swap_order);
+  }
+}
+
+// consecutive items on the same texture after sorting share one batch
+void SpriteBatch::build() {
+  if (ownership->is_built_) { return; }
+  this->sort();
+  std::vector<Item> const &items = ownership->items_;
+  std::vector<Batch> &batches = ownership->batches_;
+  usize &batch_count = ownership->batch_count_;
+  batch_count = 0;
+  for (SortEntry const &entry : ownership->order_) {
+    Item const &item = items[entry.item_code_];
+    if (batch_count == 0 ||
+        batches[batch_count - 1].texture_ != item.texture_) {
+      if (batch_count == batches.size()) {
+        batches.push_back(Batch({
+          nullptr, sf::VertexArray(sf::Triangles),
+        }));
+      }
+      batches[batch_count].texture_ = item.texture_;
+      batches[batch_count].vertices_.clear();
+      ++batch_count;
+    }
+    sf::VertexArray &vertices = batches[batch_count - 1].vertices_;
+    vertices.append(item.vertices_[0]);
+    vertices.append(item.vertices_[1]);
+    vertices.append(item.vertices_[2]);
+    vertices.append(item.vertices_[0]);
+    vertices.append(item.vertices_[2]);
+    vertices.append(item.vertices_[3]);
+  }
+  ownership->is_built_ = true;
+}
+
+SpriteBatch::Inner::Inner()
+    : items_(),
+      order_(),
+      swap_order_(),
+      texture_codes_(),
+      batches_(),
+      batch_count_(),
+      is_built_() {
+}
+
+SpriteBatch::Inner::Inner(SpriteBatch::Inner const &rhs) {
+  *this = rhs;
+}
+
+SpriteBatch::Inner &SpriteBatch::Inner::operator=(
+    SpriteBatch::Inner const &rhs) {
+  if (this == &rhs) { return *this; }
+  this->items_ = rhs.items_;
+  this->order_ = rhs.order_;
+  this->swap_order_ = rhs.swap_order_;
+  this->texture_codes_ = rhs.texture_codes_;
+  this->batches_ = rhs.batches_;
+  this->batch_count_ = rhs.batch_count_;
+  this->is_built_ = rhs.is_built_;
+  return *this;
+}
@@ -2,6 +2,106 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <cctype>
+#include <atomic>
+#include <filesystem>
+#include <thread>
+
+using isize = long;
+using f64 = double;
+
+static constexpr usize kPixelSize = 4; // rgba
+static constexpr usize kBlitGrain = 16;
+static constexpr usize kMaxFrameDigits = 9; // fits usize on every target
+
+// the formats sf::Image decodes
+static bool isImageFile(std::filesystem::path const &path) {
+  static char const *const kExtensions[] = {
+    ".png", ".jpg", ".jpeg", ".bmp", ".tga", ".gif", ".psd", ".hdr", ".pic",
+  };
+  std::string extension = path.extension().string();
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](char const &c) {
+    return char(::tolower((unsigned char)c));
+  });
+  return std::any_of(std::begin(kExtensions), std::end(kExtensions),
+                     [&extension](char const *const &image_extension) {
+    return extension == image_extension;
+  });
+}
+
+static usize ceilPowerOfTwo(usize const &n) {
+  usize power = 1;
+  while (power < n) { power <<= 1; }
+  return power;
+}
+
+struct BlitJob {
+  sf::Uint8 *page;
+  usize page_width;
+  sf::Image const *image;
+  AtlasRegion region;
+};
+
+static void blitImage(BlitJob const &job, usize const &extrusion) {
+  sf::Vector2u const &size = job.image->getSize();
+  sf::Uint8 const *source = job.image->getPixelsPtr();
+  sf::IntRect const &rect = job.region.rect;
+  auto at = [&](isize const &x, isize const &y) {
+    return job.page + (y * job.page_width + x) * kPixelSize;
+  };
+  if (!job.region.is_rotated) {
+    for (usize y = 0; y < size.y; ++y) {
+      std::memcpy(at(rect.left, rect.top + y),
+                  source + y * size.x * kPixelSize,
+                  size.x * kPixelSize);
+    }
+  } else {
+    for (usize y = 0; y < usize(rect.height); ++y) {
+      for (usize x = 0; x < usize(rect.width); ++x) {
+        std::memcpy(at(rect.left + x, rect.top + y),
+                    source + ((size.y - 1 - x) * size.x + y) * kPixelSize,
+                    kPixelSize);
+      }
+    }
+  }
+  if (extrusion == 0) { return; }
+  isize left = rect.left, right = rect.left + rect.width - 1;
+  for (isize y = rect.top; y < rect.top + rect.height; ++y) {
+    for (isize e = 1; e <= isize(extrusion); ++e) {
+      std::memcpy(at(left - e, y), at(left, y), kPixelSize);
+      std::memcpy(at(right + e, y), at(right, y), kPixelSize);
+    }
+  }
+  usize row = (rect.width + 2 * extrusion) * kPixelSize;
+  isize top = rect.top, bottom = rect.top + rect.height - 1;
+  for (isize e = 1; e <= isize(extrusion); ++e) {
+    std::memcpy(at(left - extrusion, top - e),
+                at(left - extrusion, top), row);
+    std::memcpy(at(left - extrusion, bottom + e),
+                at(left - extrusion, bottom), row);
+  }
+}
+
+// regions never overlap, so images are blitted concurrently
+static void blitImages(std::vector<BlitJob> const &jobs,
+                       usize const &extrusion) {
+  usize worker_count = std::min(
+      usize(std::max(std::thread::hardware_concurrency(), 1u)),
+      (jobs.size() + kBlitGrain - 1) / kBlitGrain);
+  std::atomic<usize> next(0);
+  auto work = [&]() {
+    for (usize i; (i = next.fetch_add(1)) < jobs.size(); ) {
+      blitImage(jobs[i], extrusion);
+    }
+  };
+  std::vector<std::thread> workers;
+  for (usize i = 1; i < worker_count; ++i) { workers.emplace_back(work); }
+  work();
+  for (std::thread &worker : workers) { worker.join(); }
+}
 
 SpriteGenerator::SpriteGenerator()
     : ownership(new SpriteGenerator::Inner()) {
@@ -41,43 +141,178 @@ SpriteGenerator SpriteGenerator::clone() const {
 }
 
 WrapTexture SpriteGenerator::generateSpriteSheet() const {
+  WrapImage image(this->generateSpriteSheetImage());
+  return WrapTexture(image.getImage());
+}
+
+WrapImage SpriteGenerator::generateSpriteSheetImage() const {
+  std::vector<std::vector<sf::IntRect>> animes;
+  sf::Vector2u const &size = this->layoutSpriteSheet(animes);
+  return this->composeSpriteSheet(animes, size);
+}
+
+Animation SpriteGenerator::generateAnimation(
+    WrapTexture &sprite_sheet,
+    DurationsStore const &durations_store) const {
   this->ownershipCheck();
+  if (durations_store.size() != ownership->images_store_.size()) {
+    throw std::runtime_error("durations_store mismatch images_store.");
+  }
+  for (usize i = 0; i < durations_store.size(); ++i) {
+    if (durations_store[i].size() != ownership->images_store_[i].size()) {
+      throw std::runtime_error("durations_store mismatch images_store.");
+    }
+  }
   std::vector<std::vector<sf::IntRect>> animes;
-  std::vector<usize> heights;
-  usize total_width = 0, total_height = 0;
-  for (WrapImages const &images : ownership->images_store_) {
-    animes.push_back(std::vector<sf::IntRect>());
-    heights.push_back(total_height);
-    usize current_width = 0, current_height = 0;
-    for (WrapImage const &image : images) {
-      sf::Vector2u const &size = image.getSize();
-      animes.back().push_back(
-          sf::IntRect({
-            i32(current_width), i32(total_height), i32(size.x), i32(size.y),
-          })
-      );
-      current_width += size.x;
-      current_height = std::max(current_height, total_height + usize(size.y));
+  sf::Vector2u const &size = this->layoutSpriteSheet(animes);
+  WrapImage image(this->composeSpriteSheet(animes, size));
+  sprite_sheet.loadFromImage(image.getImage());
+  Animation animation(animes.size());
+  for (usize i = 0; i < animes.size(); ++i) {
+    Anime anime(animes[i].size());
+    for (usize j = 0; j < animes[i].size(); ++j) {
+      anime[j] = Motion(animes[i][j], durations_store[i][j]);
     }
-    total_width = std::max(total_width, current_width);
-    total_height = current_height;
+    animation.setAnime(i, anime);
   }
-  sf::RenderTexture render_texture;
-  render_texture.create(total_width, total_height);
+  return Animation(animation);
+}
+
+Animation SpriteGenerator::generateAnimation(WrapTexture &sprite_sheet,
+                                             sf::Time const &duration) const {
+  this->ownershipCheck();
+  DurationsStore durations_store(ownership->images_store_.size());
+  for (usize i = 0; i < durations_store.size(); ++i) {
+    durations_store[i].assign(ownership->images_store_[i].size(), duration);
+  }
+  return this->generateAnimation(sprite_sheet, durations_store);
+}
+
+WrapTextures SpriteGenerator::generateAtlas(AtlasRegionsStore &regions_store,
+                                            AtlasOptions const &options
+                                            ) const {
+  WrapImages images(this->generateAtlasImages(regions_store, options));
+  WrapTextures textures;
+  textures.reserve(images.size());
+  for (WrapImage const &image : images) {
+    textures.push_back(WrapTexture(image.getImage()));
+  }
+  return WrapTextures(textures);
+}
+
+WrapImages SpriteGenerator::generateAtlasImages(
+    AtlasRegionsStore &regions_store,
+    AtlasOptions const &options) const {
+  this->ownershipCheck();
+  struct Item {
+    usize images_code;
+    usize image_code;
+    usize width;
+    usize height;
+  };
+  usize const margin = 2 * options.extrusion + options.padding;
+  usize const max_size = (options.max_size != 0 ?
+                          options.max_size :
+                          usize(sf::Texture::getMaximumSize()));
+  std::vector<Item> items;
+  regions_store.assign(ownership->images_store_.size(), AtlasRegions());
+  for (usize i = 0; i < ownership->images_store_.size(); ++i) {
+    WrapImages const &images = ownership->images_store_[i];
+    regions_store[i].assign(images.size(),
+                            AtlasRegion({ 0, sf::IntRect(), false }));
+    for (usize j = 0; j < images.size(); ++j) {
+      sf::Vector2u const &size = images[j].getSize();
+      if (size.x == 0 || size.y == 0) { continue; }
+      items.push_back(Item({ i, j, size.x + margin, size.y + margin }));
+    }
+  }
+  std::sort(items.begin(), items.end(), [](Item const &a, Item const &b) {
+    usize a_side = std::max(a.width, a.height);
+    usize b_side = std::max(b.width, b.height);
+    if (a_side != b_side) { return a_side > b_side; }
+    return a.width * a.height > b.width * b.height;
+  });
+
+  std::vector<sf::Vector2u> page_sizes;
+  while (!items.empty()) {
+    usize area = 0, min_width = 0, min_height = 0;
+    for (Item const &item : items) {
+      area += item.width * item.height;
+      min_width = std::max(min_width, item.width);
+      min_height = std::max(min_height, item.height);
+    }
+    usize side = usize(std::ceil(std::sqrt(f64(area))));
+    usize width = std::max(side, min_width);
+    usize height = std::max(side, min_height);
+    if (options.power_of_two) {
+      width = ceilPowerOfTwo(width);
+      height = ceilPowerOfTwo(height);
+    }
+    width = std::min(width, max_size);
+    height = std::min(height, max_size);
+    RectPacker packer;
+    std::vector<Item> rest;
+    while (true) {
+      packer = RectPacker(width, height, options.method,
+                          options.allow_rotation);
+      rest.clear();
+      for (Item const &item : items) {
+        RectPacker::Placement placement;
+        if (!packer.insert(item.width, item.height, placement)) {
+          rest.push_back(item);
+          continue;
+        }
+        sf::IntRect const &rect = placement.rect;
+        regions_store[item.images_code][item.image_code] = AtlasRegion({
+          page_sizes.size(),
+          sf::IntRect(rect.left + options.extrusion,
+                      rect.top + options.extrusion,
+                      rect.width - margin,
+                      rect.height - margin),
+          placement.is_rotated,
+        });
+      }
+      if (rest.empty() || (width == max_size && height == max_size)) {
+        break;
+      }
+      if (width <= height) {
+        width = std::min(width * 2, max_size);
+      } else {
+        height = std::min(height * 2, max_size);
+      }
+    }
+    if (rest.size() == items.size()) {
+      throw std::runtime_error("image exceeds atlas max_size.");
+    }
+    sf::Vector2u size = packer.getUsedSize();
+    if (options.power_of_two) {
+      size = sf::Vector2u(ceilPowerOfTwo(size.x), ceilPowerOfTwo(size.y));
+    }
+    page_sizes.push_back(size);
+    items.swap(rest);
+  }
+
+  std::vector<std::vector<sf::Uint8>> pages(page_sizes.size());
+  for (usize i = 0; i < pages.size(); ++i) {
+    pages[i].assign(usize(page_sizes[i].x) * page_sizes[i].y * kPixelSize, 0);
+  }
+  std::vector<BlitJob> jobs;
   for (usize i = 0; i < ownership->images_store_.size(); ++i) {
     for (usize j = 0; j < ownership->images_store_[i].size(); ++j) {
-      WrapTexture texture(ownership->images_store_[i][j].getImage());
-      sf::IntRect const &int_rect = animes[i][j];
-      sf::RectangleShape rectangle_shape;
-      rectangle_shape.setTexture(&texture.getTexture());
-      rectangle_shape.setPosition(int_rect.left, heights[i]);
-      rectangle_shape.setSize({ f32(int_rect.width), f32(int_rect.height) });
-      render_texture.draw(rectangle_shape);
+      AtlasRegion const &region = regions_store[i][j];
+      if (region.rect.width == 0 || region.rect.height == 0) { continue; }
+      jobs.push_back(BlitJob({
+        pages[region.page].data(), page_sizes[region.page].x,
+        &ownership->images_store_[i][j].getImage(), region,
+      }));
     }
   }
-  WrapImage image(render_texture.getTexture().copyToImage());
-  image.flipVertically();
-  return WrapTexture(image.getImage());
+  blitImages(jobs, options.extrusion);
+  WrapImages images(pages.size());
+  for (usize i = 0; i < pages.size(); ++i) {
+    images[i].create(page_sizes[i].x, page_sizes[i].y, pages[i].data());
+  }
+  return WrapImages(images);
 }
 
 WrapImagesStore const &SpriteGenerator::getImagesStore() const {
@@ -154,6 +389,35 @@ WrapImage SpriteGenerator::popBackImage(usize const &images_code) {
   return WrapImage(tmp);
 }
 
+// frames are ordered by the number before the extension, "*.img.move.N.png",
+// files that are not images are skipped and frames without a number of at
+// most kMaxFrameDigits digits go last
+void SpriteGenerator::loadImagesFromDirectory(usize const &images_code,
+                                              std::string const &directory) {
+  this->codeCheck(images_code);
+  std::vector<std::pair<usize, std::filesystem::path>> paths;
+  for (std::filesystem::directory_entry const &entry :
+       std::filesystem::directory_iterator(directory)) {
+    if (!entry.is_regular_file() || !isImageFile(entry.path())) { continue; }
+    std::string const &index = entry.path().stem().extension().string();
+    usize frame_code = usize(-1);
+    if (index.size() > 1 && index.size() <= kMaxFrameDigits + 1 &&
+        std::all_of(index.begin() + 1, index.end(), [](char const &c) {
+          return ::isdigit((unsigned char)c) != 0;
+        })) {
+      frame_code = std::stoul(index.substr(1));
+    }
+    paths.push_back({ frame_code, entry.path() });
+  }
+  std::sort(paths.begin(), paths.end());
+  WrapImages &images = ownership->images_store_[images_code];
+  images.clear();
+  images.reserve(paths.size());
+  for (std::pair<usize, std::filesystem::path> const &path : paths) {
+    images.push_back(WrapImage(path.second.string()));
+  }
+}
+
 void SpriteGenerator::create(usize const &width,
                              usize const &height,
                              sf::Color const &color) {
@@ -231,6 +495,51 @@ void SpriteGenerator::ownershipCheck() const {
   }
 }
 
+sf::Vector2u SpriteGenerator::layoutSpriteSheet(
+    std::vector<std::vector<sf::IntRect>> &animes) const {
+  this->ownershipCheck();
+  animes.clear();
+  usize total_width = 0, total_height = 0;
+  for (WrapImages const &images : ownership->images_store_) {
+    animes.push_back(std::vector<sf::IntRect>());
+    usize current_width = 0, current_height = 0;
+    for (WrapImage const &image : images) {
+      sf::Vector2u const &size = image.getSize();
+      animes.back().push_back(
+          sf::IntRect({
+            i32(current_width), i32(total_height), i32(size.x), i32(size.y),
+          })
+      );
+      current_width += size.x;
+      current_height = std::max(current_height, total_height + usize(size.y));
+    }
+    total_width = std::max(total_width, current_width);
+    total_height = current_height;
+  }
+  return sf::Vector2u(total_width, total_height);
+}
+
+WrapImage SpriteGenerator::composeSpriteSheet(
+    std::vector<std::vector<sf::IntRect>> const &animes,
+    sf::Vector2u const &size) const {
+  std::vector<sf::Uint8> pixels(usize(size.x) * size.y * kPixelSize, 0);
+  std::vector<BlitJob> jobs;
+  for (usize i = 0; i < ownership->images_store_.size(); ++i) {
+    for (usize j = 0; j < ownership->images_store_[i].size(); ++j) {
+      if (animes[i][j].width == 0 || animes[i][j].height == 0) { continue; }
+      jobs.push_back(BlitJob({
+        pixels.data(), size.x,
+        &ownership->images_store_[i][j].getImage(),
+        AtlasRegion({ 0, animes[i][j], false }),
+      }));
+    }
+  }
+  blitImages(jobs, 0);
+  WrapImage image;
+  image.create(size.x, size.y, pixels.data());
+  return WrapImage(image);
+}
+
 void SpriteGenerator::codeCheck(usize const &images_code,
                                 usize const &image_code) const {
   this->ownershipCheck();
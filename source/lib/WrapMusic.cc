@@ -0,0 +1,278 @@
+#include <lib/WrapMusic.h>
+
+#include <stdexcept>
+#include <algorithm>
+
+using i64 = long long;
+
+static constexpr usize kChunksPerSecond = 4;
+
+WrapMusic::WrapMusic()
+    : ownership(new WrapMusic::Inner()) {
+}
+
+WrapMusic::WrapMusic(std::string const &filename)
+    : ownership(new WrapMusic::Inner()) {
+  this->openFromFile(filename);
+}
+
+WrapMusic::WrapMusic(WrapMusic const &rhs) noexcept
+    : ownership() {
+  *this = rhs;
+}
+
+WrapMusic &WrapMusic::operator=(WrapMusic const &rhs) noexcept {
+  if (this == &rhs) { return *this; }
+  if (ownership != nullptr) { delete ownership; }
+  ownership = rhs.ownership;
+  const_cast<WrapMusic &>(rhs).ownership = nullptr;
+  return *this;
+}
+
+WrapMusic::~WrapMusic() noexcept {
+  if (ownership != nullptr) { delete ownership; }
+}
+
+WrapMusic WrapMusic::clone() const {
+  this->ownershipCheck();
+  return WrapMusic(new WrapMusic::Inner(*ownership));
+}
+
+void WrapMusic::openFromFile(std::string const &filename) {
+  this->ownershipCheck();
+  ownership->stream_->openFromFile(filename);
+  ownership->filename_ = filename;
+  this->applyVolume();
+}
+
+void WrapMusic::play() {
+  this->ownershipCheck();
+  ownership->stream_->play();
+}
+
+void WrapMusic::pause() {
+  this->ownershipCheck();
+  ownership->stream_->pause();
+}
+
+void WrapMusic::stop() {
+  this->ownershipCheck();
+  ownership->stream_->stop();
+  ownership->is_fading_ = false;
+}
+
+sf::SoundSource::Status WrapMusic::getStatus() const {
+  this->ownershipCheck();
+  return ownership->stream_->getStatus();
+}
+
+bool WrapMusic::getLoop() const {
+  this->ownershipCheck();
+  return ownership->stream_->getLoop();
+}
+
+void WrapMusic::setLoop(bool const &is_loop) {
+  this->ownershipCheck();
+  ownership->stream_->setLoop(is_loop);
+}
+
+f32 const &WrapMusic::getVolume() const {
+  this->ownershipCheck();
+  return ownership->volume_;
+}
+
+void WrapMusic::setVolume(f32 const &volume) {
+  this->ownershipCheck();
+  ownership->volume_ = std::min(std::max(volume, 0.0f), 100.0f);
+  this->applyVolume();
+}
+
+sf::Time WrapMusic::getDuration() const {
+  this->ownershipCheck();
+  return ownership->stream_->getDuration();
+}
+
+// the stream keeps counting across loops, fold it back into the track
+sf::Time WrapMusic::getPlayingOffset() const {
+  this->ownershipCheck();
+  sf::Time offset = ownership->stream_->getPlayingOffset();
+  sf::Time duration = ownership->stream_->getDuration();
+  if (duration > sf::Time::Zero) { offset = offset % duration; }
+  return offset;
+}
+
+void WrapMusic::setPlayingOffset(sf::Time const &offset) {
+  this->ownershipCheck();
+  sf::Time duration = ownership->stream_->getDuration();
+  if (duration <= sf::Time::Zero) { return; }
+  sf::Time target = offset;
+  if (ownership->stream_->getLoop()) {
+    target = target % duration;
+    if (target < sf::Time::Zero) { target += duration; }
+  } else {
+    target = std::min(std::max(target, sf::Time::Zero), duration);
+  }
+  ownership->stream_->setPlayingOffset(target);
+}
+
+f32 const &WrapMusic::getGain() const {
+  this->ownershipCheck();
+  return ownership->gain_;
+}
+
+void WrapMusic::fade(f32 const &gain,
+                     sf::Time const &duration,
+                     bool const &stop_after) {
+  this->ownershipCheck();
+  ownership->fade_from_ = ownership->gain_;
+  ownership->fade_to_ = std::min(std::max(gain, 0.0f), 1.0f);
+  ownership->fade_elapsed_ = sf::Time::Zero;
+  ownership->fade_duration_ = duration;
+  ownership->is_fading_ = true;
+  ownership->stop_after_fade_ = stop_after;
+  this->update(sf::Time::Zero);
+}
+
+void WrapMusic::crossfade(WrapMusic &next, sf::Time const &duration) {
+  this->ownershipCheck();
+  next.ownershipCheck();
+  if (next.getStatus() != sf::SoundSource::Playing) {
+    next.ownership->gain_ = 0.0f;
+    next.applyVolume();
+    next.play();
+  }
+  next.fade(1.0f, duration);
+  this->fade(0.0f, duration, true);
+}
+
+bool WrapMusic::isFading() const {
+  this->ownershipCheck();
+  return ownership->is_fading_;
+}
+
+void WrapMusic::update(sf::Time const &dt) {
+  this->ownershipCheck();
+  if (!ownership->is_fading_) { return; }
+  ownership->fade_elapsed_ += dt;
+  f32 progress = 1.0f;
+  if (ownership->fade_elapsed_ < ownership->fade_duration_) {
+    progress = ownership->fade_elapsed_ / ownership->fade_duration_;
+  }
+  ownership->gain_ = (ownership->fade_from_ +
+                      (ownership->fade_to_ - ownership->fade_from_) *
+                      progress);
+  this->applyVolume();
+  if (progress >= 1.0f) {
+    ownership->is_fading_ = false;
+    if (ownership->stop_after_fade_) { ownership->stream_->stop(); }
+  }
+}
+
+WrapMusic::Stream::Stream()
+    : is_loop_(false) {
+}
+
+// stop the stream thread before onGetData goes away
+WrapMusic::Stream::~Stream() {
+  this->stop();
+}
+
+void WrapMusic::Stream::openFromFile(std::string const &filename) {
+  this->stop();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!file_.openFromFile(filename)) {
+    throw std::runtime_error(std::string("load from file failed: ") + filename);
+  }
+  samples_.assign(file_.getSampleRate() / kChunksPerSecond *
+                  file_.getChannelCount(), 0);
+  this->initialize(file_.getChannelCount(), file_.getSampleRate());
+}
+
+sf::Time WrapMusic::Stream::getDuration() const {
+  return file_.getDuration();
+}
+
+bool WrapMusic::Stream::getLoop() const {
+  return is_loop_;
+}
+
+void WrapMusic::Stream::setLoop(bool const &is_loop) {
+  is_loop_ = is_loop;
+}
+
+// the chunk wraps around the end of the track while looping, so the
+// queue never runs dry at the loop point
+bool WrapMusic::Stream::onGetData(sf::SoundStream::Chunk &data) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  usize count = 0;
+  bool is_rewound = false;
+  while (count < samples_.size()) {
+    usize read = file_.read(samples_.data() + count, samples_.size() - count);
+    count += read;
+    if (read != 0) {
+      is_rewound = false;
+    } else if (is_loop_ && !is_rewound) {
+      file_.seek(sf::Uint64(0));
+      is_rewound = true;
+    } else {
+      break;
+    }
+  }
+  data.samples = samples_.data();
+  data.sampleCount = count;
+  return count == samples_.size();
+}
+
+void WrapMusic::Stream::onSeek(sf::Time timeOffset) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  file_.seek(timeOffset);
+}
+
+WrapMusic::Inner::Inner()
+    : stream_(new WrapMusic::Stream()),
+      volume_(100.0f),
+      gain_(1.0f),
+      fade_from_(1.0f),
+      fade_to_(1.0f),
+      is_fading_(false),
+      stop_after_fade_(false) {
+}
+
+WrapMusic::Inner::Inner(WrapMusic::Inner const &rhs)
+    : stream_(new WrapMusic::Stream()) {
+  *this = rhs;
+}
+
+// streams cannot be copied, reopen the same file instead
+WrapMusic::Inner &WrapMusic::Inner::operator=(WrapMusic::Inner const &rhs) {
+  if (this == &rhs) { return *this; }
+  if (!rhs.filename_.empty()) {
+    this->stream_->openFromFile(rhs.filename_);
+    this->stream_->setVolume(rhs.stream_->getVolume());
+  }
+  this->stream_->setLoop(rhs.stream_->getLoop());
+  this->filename_ = rhs.filename_;
+  this->volume_ = rhs.volume_;
+  this->gain_ = rhs.gain_;
+  this->fade_from_ = rhs.fade_from_;
+  this->fade_to_ = rhs.fade_to_;
+  this->fade_elapsed_ = rhs.fade_elapsed_;
+  this->fade_duration_ = rhs.fade_duration_;
+  this->is_fading_ = rhs.is_fading_;
+  this->stop_after_fade_ = rhs.stop_after_fade_;
+  return *this;
+}
+
+WrapMusic::WrapMusic(WrapMusic::Inner *const &ownership) noexcept
+    : ownership(ownership) {
+}
+
+void WrapMusic::ownershipCheck() const {
+  if (ownership == nullptr) {
+    throw std::runtime_error("No ownership rights whatsoever: WrapMusic");
+  }
+}
+
+void WrapMusic::applyVolume() {
+  ownership->stream_->setVolume(ownership->volume_ * ownership->gain_);
+}
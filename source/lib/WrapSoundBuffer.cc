@@ -1,14 +1,165 @@
 #include <lib/WrapSoundBuffer.h>
 
 #include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+using i32 = int;
+using u64 = unsigned long long;
+using f64 = double;
+using Samples = std::vector<sf::Int16>;
+
+static constexpr usize kAdpcmBlockFrames = 1024;
+static constexpr i32 kAdpcmSteps[89] = {
+  7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41,
+  45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209,
+  230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876,
+  963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+  3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493,
+  10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086,
+  29794, 32767,
+};
+static constexpr i32 kAdpcmIndices[16] = {
+  -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8,
+};
+
+static void adpcmStep(u8 const &nibble, i32 &predictor, i32 &index) {
+  i32 step = kAdpcmSteps[index];
+  i32 diff = step >> 3;
+  if (nibble & 4) { diff += step; }
+  if (nibble & 2) { diff += step >> 1; }
+  if (nibble & 1) { diff += step >> 2; }
+  predictor += (nibble & 8 ? -diff : diff);
+  predictor = std::min(std::max(predictor, -32768), 32767);
+  index = std::min(std::max(index + kAdpcmIndices[nibble], 0), 88);
+}
+
+static u8 adpcmEncode(i32 const &sample, i32 &predictor, i32 &index) {
+  i32 step = kAdpcmSteps[index];
+  i32 diff = sample - predictor;
+  u8 nibble = 0;
+  if (diff < 0) {
+    nibble = 8;
+    diff = -diff;
+  }
+  if (diff >= step) {
+    nibble |= 4;
+    diff -= step;
+  }
+  step >>= 1;
+  if (diff >= step) {
+    nibble |= 2;
+    diff -= step;
+  }
+  step >>= 1;
+  if (diff >= step) { nibble |= 1; }
+  adpcmStep(nibble, predictor, index);
+  return nibble;
+}
+
+// per block and channel: i16 first sample, u8 step index, u8 zero,
+// then the remaining frames as nibbles, low nibble first
+static std::vector<u8> encodeAdpcm(Samples const &samples,
+                                   u32 const &channel_count) {
+  usize frame_count = samples.size() / channel_count;
+  std::vector<u8> bytes;
+  bytes.reserve(samples.size() / 2 +
+                (frame_count / kAdpcmBlockFrames + 1) * channel_count * 4);
+  std::vector<i32> indices(channel_count, 0);
+  for (usize first = 0; first < frame_count; first += kAdpcmBlockFrames) {
+    usize count = std::min(kAdpcmBlockFrames, frame_count - first);
+    for (u32 c = 0; c < channel_count; ++c) {
+      i32 predictor = samples[first * channel_count + c];
+      bytes.push_back(u8(predictor));
+      bytes.push_back(u8(predictor >> 8));
+      bytes.push_back(u8(indices[c]));
+      bytes.push_back(u8(0));
+      u8 byte = 0;
+      for (usize f = 1; f < count; ++f) {
+        u8 nibble = adpcmEncode(samples[(first + f) * channel_count + c],
+                                predictor,
+                                indices[c]);
+        if (f % 2 == 1) {
+          byte = nibble;
+        } else {
+          bytes.push_back(u8(byte | nibble << 4));
+        }
+      }
+      if (count % 2 == 0) { bytes.push_back(byte); }
+    }
+  }
+  return bytes;
+}
+
+static Samples decodeAdpcm(std::vector<u8> const &bytes,
+                           usize const &frame_count,
+                           u32 const &channel_count) {
+  Samples samples(frame_count * channel_count);
+  usize cursor = 0;
+  for (usize first = 0; first < frame_count; first += kAdpcmBlockFrames) {
+    usize count = std::min(kAdpcmBlockFrames, frame_count - first);
+    for (u32 c = 0; c < channel_count; ++c) {
+      i32 predictor = sf::Int16(bytes[cursor] | bytes[cursor + 1] << 8);
+      i32 index = bytes[cursor + 2];
+      cursor += 4;
+      samples[first * channel_count + c] = sf::Int16(predictor);
+      for (usize f = 1; f < count; ++f) {
+        u8 nibble = (f % 2 == 1 ?
+                     bytes[cursor] & 0x0f :
+                     bytes[cursor++] >> 4);
+        adpcmStep(nibble, predictor, index);
+        samples[(first + f) * channel_count + c] = sf::Int16(predictor);
+      }
+      if (count % 2 == 0) { ++cursor; }
+    }
+  }
+  return samples;
+}
+
+static Samples downmix(Samples const &samples, u32 const &channel_count) {
+  Samples mono(samples.size() / channel_count);
+  for (usize f = 0; f < mono.size(); ++f) {
+    i32 sum = 0;
+    for (u32 c = 0; c < channel_count; ++c) {
+      sum += samples[f * channel_count + c];
+    }
+    mono[f] = sf::Int16(sum / i32(channel_count));
+  }
+  return mono;
+}
+
+// linear interpolation, good enough for effects
+static Samples resample(Samples const &samples,
+                        u32 const &channel_count,
+                        u32 const &sample_rate,
+                        u32 const &target_rate) {
+  usize frame_count = samples.size() / channel_count;
+  usize target_count = std::max<usize>(
+      usize(u64(frame_count) * target_rate / sample_rate), 1);
+  Samples resampled(target_count * channel_count);
+  f64 ratio = f64(sample_rate) / target_rate;
+  for (usize f = 0; f < target_count; ++f) {
+    f64 position = f * ratio;
+    usize i0 = std::min(usize(position), frame_count - 1);
+    usize i1 = std::min(i0 + 1, frame_count - 1);
+    f64 t = position - i0;
+    for (u32 c = 0; c < channel_count; ++c) {
+      f64 value = (samples[i0 * channel_count + c] * (1.0 - t) +
+                   samples[i1 * channel_count + c] * t);
+      resampled[f * channel_count + c] = sf::Int16(std::lround(value));
+    }
+  }
+  return resampled;
+}
 
 WrapSoundBuffer::WrapSoundBuffer()
     : ownership(new WrapSoundBuffer::Inner()) {
 }
 
-WrapSoundBuffer::WrapSoundBuffer(std::string const &filename)
+WrapSoundBuffer::WrapSoundBuffer(std::string const &filename,
+                                 SoundBufferOptions const &options)
     : ownership(new WrapSoundBuffer::Inner()) {
-  this->loadFromFile(filename);
+  this->loadFromFile(filename, options);
 }
 
 WrapSoundBuffer::WrapSoundBuffer(void const *data, std::size_t sizeInBytes)
@@ -58,81 +209,142 @@ WrapSoundBuffer WrapSoundBuffer::clone() const {
 }
 
 sf::SoundBuffer &WrapSoundBuffer::getSoundBuffer() {
-  this->ownershipCheck();
+  this->decode();
   return ownership->sound_buffer_;
 }
 
 sf::SoundBuffer const &WrapSoundBuffer::getSoundBuffer() const {
-  this->ownershipCheck();
+  this->decode();
   return ownership->sound_buffer_;
 }
 
-void WrapSoundBuffer::loadFromFile(std::string const &filename) {
+void WrapSoundBuffer::loadFromFile(std::string const &filename,
+                                   SoundBufferOptions const &options) {
   this->ownershipCheck();
+  ownership->is_compressed_ = false;
+  ownership->adpcm_.clear();
   if (!ownership->sound_buffer_.loadFromFile(filename)) {
     throw std::runtime_error(std::string("load from file failed: ") + filename);
   }
+  this->applyOptions(options);
 }
 
 void WrapSoundBuffer::loadFromMemory(void const *data,
-                                     std::size_t sizeInBytes) {
+                                     std::size_t sizeInBytes,
+                                     SoundBufferOptions const &options) {
   this->ownershipCheck();
+  ownership->is_compressed_ = false;
+  ownership->adpcm_.clear();
   if (!ownership->sound_buffer_.loadFromMemory(data, sizeInBytes)) {
     throw std::runtime_error("load from memory failed");
   }
+  this->applyOptions(options);
 }
 
-void WrapSoundBuffer::loadFromStream(sf::InputStream &stream) {
+void WrapSoundBuffer::loadFromStream(sf::InputStream &stream,
+                                     SoundBufferOptions const &options) {
   this->ownershipCheck();
+  ownership->is_compressed_ = false;
+  ownership->adpcm_.clear();
   if (!ownership->sound_buffer_.loadFromStream(stream)) {
     throw std::runtime_error("load from stream failed");
   }
+  this->applyOptions(options);
 }
 
 void WrapSoundBuffer::loadFromSamples(sf::Int16 const *samples,
                                       sf::Uint64 sampleCount,
                                       u32 channelCount,
-                                      u32 sampleRate) {
+                                      u32 sampleRate,
+                                      SoundBufferOptions const &options) {
   this->ownershipCheck();
+  ownership->is_compressed_ = false;
+  ownership->adpcm_.clear();
   if (!ownership->sound_buffer_.loadFromSamples(
         samples, sampleCount, channelCount, sampleRate)) {
     throw std::runtime_error("load from samples failed");
   }
+  this->applyOptions(options);
 }
 
 void WrapSoundBuffer::saveToFile(std::string const &filename) const {
-  this->ownershipCheck();
+  this->decode();
   if (!ownership->sound_buffer_.saveToFile(filename)) {
     throw std::runtime_error("save to file failed");
   }
 }
 
-sf::Int16 const *WrapSoundBuffer::getSamples() const {
+void WrapSoundBuffer::compact(SoundBufferOptions const &options) {
   this->ownershipCheck();
+  this->applyOptions(options);
+}
+
+bool WrapSoundBuffer::isCompressed() const {
+  this->ownershipCheck();
+  return ownership->is_compressed_;
+}
+
+bool WrapSoundBuffer::isDecoded() const {
+  this->ownershipCheck();
+  return !ownership->is_compressed_ || ownership->is_decoded_;
+}
+
+void WrapSoundBuffer::releaseDecoded() const {
+  this->ownershipCheck();
+  if (!ownership->is_compressed_ || !ownership->is_decoded_) { return; }
+  ownership->sound_buffer_ = sf::SoundBuffer();
+  ownership->is_decoded_ = false;
+}
+
+usize WrapSoundBuffer::getMemoryUsage() const {
+  this->ownershipCheck();
+  usize usage = ownership->adpcm_.size();
+  if (this->isDecoded()) {
+    usage += usize(ownership->sound_buffer_.getSampleCount()) *
+             sizeof(sf::Int16);
+  }
+  return usage;
+}
+
+sf::Int16 const *WrapSoundBuffer::getSamples() const {
+  this->decode();
   return ownership->sound_buffer_.getSamples();
 }
 
 sf::Uint64 WrapSoundBuffer::getSampleCount() const {
   this->ownershipCheck();
+  if (ownership->is_compressed_) { return ownership->sample_count_; }
   return ownership->sound_buffer_.getSampleCount();
 }
 
 u32 WrapSoundBuffer::getSampleRate() const {
   this->ownershipCheck();
+  if (ownership->is_compressed_) { return ownership->sample_rate_; }
   return ownership->sound_buffer_.getSampleRate();
 }
 
 u32 WrapSoundBuffer::getChannelCount() const {
   this->ownershipCheck();
+  if (ownership->is_compressed_) { return ownership->channel_count_; }
   return ownership->sound_buffer_.getChannelCount();
 }
 
 sf::Time WrapSoundBuffer::getDuration() const {
   this->ownershipCheck();
+  if (ownership->is_compressed_) {
+    return sf::microseconds(sf::Int64(
+        ownership->sample_count_ / ownership->channel_count_ * 1000000 /
+        ownership->sample_rate_));
+  }
   return ownership->sound_buffer_.getDuration();
 }
 
-WrapSoundBuffer::Inner::Inner() {
+WrapSoundBuffer::Inner::Inner()
+    : sample_count_(0),
+      sample_rate_(0),
+      channel_count_(0),
+      is_compressed_(false),
+      is_decoded_(false) {
 }
 
 WrapSoundBuffer::Inner::Inner(WrapSoundBuffer::Inner const &rhs) {
@@ -143,6 +355,12 @@ WrapSoundBuffer::Inner &WrapSoundBuffer::Inner::operator=(
     WrapSoundBuffer::Inner const &rhs) {
   if (this == &rhs) { return *this; }
   this->sound_buffer_ = rhs.sound_buffer_;
+  this->adpcm_.assign(rhs.adpcm_.begin(), rhs.adpcm_.end());
+  this->sample_count_ = rhs.sample_count_;
+  this->sample_rate_ = rhs.sample_rate_;
+  this->channel_count_ = rhs.channel_count_;
+  this->is_compressed_ = rhs.is_compressed_;
+  this->is_decoded_ = rhs.is_decoded_;
   return *this;
 }
 
@@ -156,3 +374,62 @@ void WrapSoundBuffer::ownershipCheck() const {
     throw std::runtime_error("No ownership rights whatsoever: WrapSoundBuffer");
   }
 }
+
+void WrapSoundBuffer::decode() const {
+  this->ownershipCheck();
+  if (!ownership->is_compressed_ || ownership->is_decoded_) { return; }
+  Samples samples = decodeAdpcm(
+      ownership->adpcm_,
+      usize(ownership->sample_count_ / ownership->channel_count_),
+      ownership->channel_count_);
+  if (!ownership->sound_buffer_.loadFromSamples(samples.data(),
+                                                samples.size(),
+                                                ownership->channel_count_,
+                                                ownership->sample_rate_)) {
+    throw std::runtime_error("load from samples failed");
+  }
+  ownership->is_decoded_ = true;
+}
+
+void WrapSoundBuffer::applyOptions(SoundBufferOptions const &options) {
+  bool is_mono = options.is_mono && this->getChannelCount() > 1;
+  bool is_resampled = (options.sample_rate != 0 &&
+                       options.sample_rate != this->getSampleRate());
+  if (!is_mono && !is_resampled &&
+      options.is_compressed == ownership->is_compressed_) {
+    return;
+  }
+  if (this->getSampleCount() == 0) { return; }
+  u32 channel_count = this->getChannelCount();
+  u32 sample_rate = this->getSampleRate();
+  Samples samples(this->getSamples(),
+                  this->getSamples() + this->getSampleCount());
+  if (is_mono) {
+    samples = downmix(samples, channel_count);
+    channel_count = 1;
+  }
+  if (is_resampled) {
+    samples = resample(samples, channel_count, sample_rate,
+                       options.sample_rate);
+    sample_rate = options.sample_rate;
+  }
+  if (options.is_compressed) {
+    ownership->adpcm_ = encodeAdpcm(samples, channel_count);
+    ownership->sample_count_ = samples.size();
+    ownership->sample_rate_ = sample_rate;
+    ownership->channel_count_ = channel_count;
+    ownership->sound_buffer_ = sf::SoundBuffer();
+    ownership->is_compressed_ = true;
+    ownership->is_decoded_ = false;
+  } else {
+    ownership->adpcm_.clear();
+    ownership->adpcm_.shrink_to_fit();
+    ownership->is_compressed_ = false;
+    if (!ownership->sound_buffer_.loadFromSamples(samples.data(),
+                                                  samples.size(),
+                                                  channel_count,
+                                                  sample_rate)) {
+      throw std::runtime_error("load from samples failed");
+    }
+  }
+}
@@ -1,3 +1,30 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
 #include <dev/Program.h>
 
-int main() { Program::run(); }
+// --record <file> saves the session's input, --replay <file> plays it back,
+// --pipelined renders on its own thread while the next tick updates
+int main(int argc, char **argv) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg(argv[i]);
+    if (arg == "--pipelined") {
+      Program::setPipelined(true);
+    } else if (i + 1 < argc && arg == "--record") {
+      Program::setRecordFilename(argv[++i]);
+    } else if (i + 1 < argc && arg == "--replay") {
+      Program::setReplayFilename(argv[++i]);
+    } else {
+      std::cerr << "usage: sfml [--pipelined] "
+                   "[--record file | --replay file]\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if (!Program::getRecordFilename().empty() &&
+      !Program::getReplayFilename().empty()) {
+    std::cerr << "sfml: --record and --replay cannot be used together\n";
+    return EXIT_FAILURE;
+  }
+  Program::run();
+}
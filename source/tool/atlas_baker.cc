@@ -0,0 +1,126 @@
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <lib/SpriteAtlas.h>
+#include <lib/SpriteGenerator.h>
+
+using i32 = int;
+using f32 = float;
+using usize = unsigned long;
+
+static void usage() {
+  std::cerr <<
+      "usage: atlas_baker <output.atlas> <frame_dir>... [options]\n"
+      "  frame_dir       one animation, frames named *.N.png\n"
+      "  --root DIR      anime names are frame_dir relative to DIR\n"
+      "  --duration MS   duration per frame (default 100)\n"
+      "  --origin MODE   bottom | center | topleft (default bottom)\n"
+      "  --max-size N    max page size (default 4096)\n"
+      "  --padding N     pixels between frames (default 2)\n"
+      "  --extrude N     edge extrusion (default 1)\n"
+      "  --skyline       skyline packing instead of max rects\n"
+      "  --rotate        allow 90 degree rotation\n"
+      "  --pot           power of two pages\n";
+}
+
+int main(int argc, char **argv) {
+  std::string output;
+  std::string root;
+  std::vector<std::string> directories;
+  i32 duration = 100;
+  std::string origin = "bottom";
+  AtlasOptions options;
+  options.max_size = 4096;
+  options.padding = 2;
+  options.extrusion = 1;
+  try {
+    for (i32 i = 1; i < argc; ++i) {
+      std::string const arg(argv[i]);
+      auto value = [&]() -> std::string {
+        if (i + 1 >= argc) {
+          throw std::runtime_error(arg + " requires a value");
+        }
+        return std::string(argv[++i]);
+      };
+      if (arg == "--root") {
+        root = value();
+      } else if (arg == "--duration") {
+        duration = std::stoi(value());
+      } else if (arg == "--origin") {
+        origin = value();
+      } else if (arg == "--max-size") {
+        options.max_size = std::stoul(value());
+      } else if (arg == "--padding") {
+        options.padding = std::stoul(value());
+      } else if (arg == "--extrude") {
+        options.extrusion = std::stoul(value());
+      } else if (arg == "--skyline") {
+        options.method = RectPacker::kSkyline;
+      } else if (arg == "--rotate") {
+        options.allow_rotation = true;
+      } else if (arg == "--pot") {
+        options.power_of_two = true;
+      } else if (arg.rfind("--", 0) == 0) {
+        throw std::runtime_error("unknown option: " + arg);
+      } else if (output.empty()) {
+        output = arg;
+      } else {
+        directories.push_back(arg);
+      }
+    }
+    if (output.empty() || directories.empty()) {
+      usage();
+      return EXIT_FAILURE;
+    }
+    if (origin != "bottom" && origin != "center" && origin != "topleft") {
+      throw std::runtime_error("unknown origin: " + origin);
+    }
+
+    SpriteGenerator generator(directories.size());
+    std::vector<std::string> names;
+    for (usize i = 0; i < directories.size(); ++i) {
+      generator.loadImagesFromDirectory(i, directories[i]);
+      std::filesystem::path name(directories[i]);
+      if (!root.empty()) {
+        name = std::filesystem::relative(name, root);
+      }
+      names.push_back(name.generic_string());
+    }
+
+    AtlasRegionsStore regions_store;
+    WrapImages pages(generator.generateAtlasImages(regions_store, options));
+    AtlasFramesStore frames_store(regions_store.size());
+    usize frame_count = 0;
+    for (usize i = 0; i < regions_store.size(); ++i) {
+      for (usize j = 0; j < regions_store[i].size(); ++j) {
+        AtlasRegion const &region = regions_store[i][j];
+        sf::Vector2u const &size = generator.getImage(i, j).getSize();
+        sf::Vector2f anchor;
+        if (origin == "bottom") {
+          anchor = sf::Vector2f(size.x / 2.0f, f32(size.y));
+        } else if (origin == "center") {
+          anchor = sf::Vector2f(size.x / 2.0f, size.y / 2.0f);
+        }
+        frames_store[i].push_back(AtlasFrame({
+          region.page, region.rect, region.is_rotated, anchor,
+          sf::milliseconds(duration),
+        }));
+        ++frame_count;
+      }
+    }
+
+    SpriteAtlas atlas;
+    atlas.create(pages, names, frames_store);
+    atlas.saveToFile(output);
+    std::cout << output << ": " << names.size() << " animes, "
+              << frame_count << " frames, " << pages.size() << " pages\n";
+  } catch (std::exception const &e) {
+    std::cerr << "atlas_baker: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
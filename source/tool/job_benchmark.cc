@@ -0,0 +1,133 @@
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include <lib/JobManager.h>
+#include <lib/ObjectManager.h>
+#include <lib/PhysicsManager.h>
+
+using i32 = int;
+using u32 = unsigned int;
+using usize = unsigned long;
+using f32 = float;
+using f64 = double;
+
+static void usage() {
+  std::cerr <<
+      "usage: job_benchmark [options]\n"
+      "  --objects N     objects in the scene (default 50000)\n"
+      "  --frames N      frames measured per run (default 120)\n"
+      "  --max-workers N highest worker count (default hardware)\n";
+}
+
+// synthetic frame: animation advance, physics, ai and culling passes
+static f64 measure(usize const &worker_count,
+                   usize const &object_count,
+                   usize const &frame_count) {
+  JobManager::initialize(worker_count - 1);
+  ObjectManager::clear();
+  PhysicsManager::initialize();
+  PhysicsManager::addFoothold(sf::Vector2f(-100000, 1000),
+                              sf::Vector2f(100000, 1000));
+  std::vector<usize> bodies(object_count);
+  std::vector<f32> cursors(object_count);
+  std::vector<u32> seeds(object_count);
+  std::vector<u32> visibles(object_count);
+  ObjectManager::reserve(object_count);
+  PhysicsManager::reserve(object_count);
+  for (usize i = 0; i < object_count; ++i) {
+    ObjectManager::Handle handle = ObjectManager::create(
+        sf::Vector2f(f32(i % 1000) * 40.0f, f32(i / 1000) * -20.0f));
+    bodies[i] = PhysicsManager::createBody(handle, sf::Vector2f(40, 60));
+    seeds[i] = u32(i) * 2654435761u + 1;
+  }
+  sf::FloatRect const view(0, 0, 1280, 1000);
+  sf::Time const dt = sf::microseconds(1000000 / 120);
+
+  auto frame = [&]() {
+    JobManager::parallelFor(0, object_count, 0,
+                            [&](usize const &begin, usize const &end) {
+      for (usize i = begin; i < end; ++i) { // animation advance
+        cursors[i] = std::fmod(cursors[i] + dt.asSeconds() * 10.0f, 8.0f);
+        ObjectManager::getRotations()[i] = std::sin(cursors[i]) * 5.0f;
+      }
+    });
+    JobManager::parallelFor(0, object_count, 0,
+                            [&](usize const &begin, usize const &end) {
+      for (usize i = begin; i < end; ++i) { // ai, wander left and right
+        u32 &seed = seeds[i];
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        if (seed % 64 == 0) {
+          PhysicsManager::walk(bodies[i], f32(i32(seed % 400) - 200));
+        }
+      }
+    });
+    PhysicsManager::step(dt);
+    JobManager::parallelFor(0, object_count, 0,
+                            [&](usize const &begin, usize const &end) {
+      for (usize i = begin; i < end; ++i) { // culling
+        sf::FloatRect bounds = ObjectManager::getTransform(i).transformRect(
+            sf::FloatRect(-20, -60, 40, 60));
+        visibles[i] = bounds.intersects(view);
+      }
+    });
+  };
+
+  for (usize i = 0; i < 30; ++i) { frame(); } // settle and warm up
+  auto start = std::chrono::steady_clock::now();
+  for (usize i = 0; i < frame_count; ++i) { frame(); }
+  f64 elapsed = std::chrono::duration<f64, std::milli>(
+      std::chrono::steady_clock::now() - start).count();
+
+  PhysicsManager::release();
+  ObjectManager::clear();
+  JobManager::release();
+  return elapsed / frame_count;
+}
+
+int main(int argc, char **argv) {
+  usize object_count = 50000;
+  usize frame_count = 120;
+  usize max_workers = std::max(std::thread::hardware_concurrency(), 1u);
+  try {
+    for (int i = 1; i < argc; ++i) {
+      std::string arg(argv[i]);
+      if (i + 1 < argc && arg == "--objects") {
+        object_count = std::stoul(argv[++i]);
+      } else if (i + 1 < argc && arg == "--frames") {
+        frame_count = std::stoul(argv[++i]);
+      } else if (i + 1 < argc && arg == "--max-workers") {
+        max_workers = std::max(std::stoul(argv[++i]), 1ul);
+      } else {
+        usage();
+        return EXIT_FAILURE;
+      }
+    }
+
+    std::cout << object_count << " objects, " << frame_count
+              << " frames\nworkers  ms/frame  speedup\n";
+    f64 base = 0.0;
+    for (usize workers = 1; workers <= max_workers; ++workers) {
+      f64 ms = measure(workers, object_count, frame_count);
+      if (workers == 1) { base = ms; }
+      std::cout << std::setw(7) << workers << std::fixed
+                << std::setprecision(3) << std::setw(10) << ms
+                << std::setprecision(2) << std::setw(9) << base / ms
+                << "x\n";
+    }
+  } catch (std::exception const &e) {
+    std::cerr << "job_benchmark: " << e.what() << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}